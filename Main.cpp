@@ -1,11 +1,22 @@
 #include <raylib.h>
 #include <raymath.h>
+#include <rlgl.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <new>
+#include <thread>
+#include <type_traits>
 
 const int TARGET_FPS(60);
 const float TIMESTEP(1.0f / TARGET_FPS);
+const int SIMULATION_RATE(240);  // Physics steps per second, on its own thread
+const float SIMULATION_TIMESTEP(1.0f / SIMULATION_RATE);
 const int WINDOW_WIDTH(800);
 const int WINDOW_HEIGHT(600);
 
@@ -25,6 +36,28 @@ const int FORCE_MULTIPLIER(75);
 const float HITFORCE_LIMIT(30000.0f);
 const float ELASTICITY(0.5f);
 
+// Draw layers, the table is drawn below everything else in the frame
+const int TABLE_LAYER(0);
+const int UI_LAYER(1);
+
+// Quieter hits are dropped or replaced once this many are playing
+const int BALL_HIT_MAX_VOICES(8);
+// Hits of the same sound closer than this play as one, at the loudest volume
+const float SOUND_COALESCE_WINDOW(0.03f);
+// Pan range across the table width, 1.0 goes from hard left to hard right
+const float SOUND_PAN_SPREAD(0.8f);
+// Volume lost by sounds at the table corners, the player listens from the center
+const float SOUND_DISTANCE_ATTENUATION(0.4f);
+
+const int MAX_COLLISION_EVENTS(256);
+const int COMMAND_QUEUE_SIZE(16);
+const int MAX_SHOT_EVENTS(2048);
+
+const size_t TABLE_ARENA_SIZE(16 * 1024);
+const size_t STEP_ARENA_SIZE(16 * 1024);
+const size_t SHOT_ARENA_SIZE(64 * 1024);
+const unsigned char ARENA_POISON(0xCD);
+
 struct Circle {
   Vector2 position = {0.0f, 0.0f};
   Vector2 velocity = {0.0f, 0.0f};
@@ -36,16 +69,14 @@ struct Circle {
 
   bool active = true;
 
-  void draw() { DrawCircle(position.x, position.y, radius, color); }
-
   void update(Vector2 force = {0.0f, 0.0f}, float timestep = TIMESTEP) {
     acceleration = Vector2Add(
       Vector2Scale(force, 1 / mass), (Vector2Scale(velocity, FRICTION))
     );  // Sum of all forces
-    velocity = Vector2Add(velocity, Vector2Scale(acceleration, TIMESTEP));
+    velocity = Vector2Add(velocity, Vector2Scale(acceleration, timestep));
     velocity.x = (abs(velocity.x) < VELOCITY_THRESHOLD) ? 0.0f : velocity.x;
     velocity.y = (abs(velocity.y) < VELOCITY_THRESHOLD) ? 0.0f : velocity.y;
-    position = Vector2Add(position, Vector2Scale(velocity, TIMESTEP));
+    position = Vector2Add(position, Vector2Scale(velocity, timestep));
   }
 
   bool isMoving() {
@@ -73,6 +104,271 @@ struct Hole {
   void draw() { DrawCircle(position.x, position.y, radius, BLACK); }
 };
 
+// Static scene drawn once into a render texture and blitted every frame.
+// Rendered again only when the screen size changes or it is invalidated.
+struct BackgroundCache {
+  RenderTexture2D target = {0};
+  bool valid = false;
+
+  // Returns true when the cache has to be drawn again, drawing goes to the
+  // texture until end()
+  bool begin() {
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+    if (valid && target.texture.width == width &&
+        target.texture.height == height)
+      return false;
+
+    if (target.id > 0) UnloadRenderTexture(target);
+    target = LoadRenderTexture(width, height);
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+    return true;
+  }
+
+  void end() {
+    EndTextureMode();
+    valid = true;
+  }
+
+  void invalidate() { valid = false; }
+
+  void draw() {
+    // Render textures are stored upside down
+    Rectangle source = {
+      0.0f, 0.0f, (float)target.texture.width, (float)-target.texture.height
+    };
+    DrawTextureRec(target.texture, source, {0.0f, 0.0f}, WHITE);
+  }
+
+  void unload() {
+    if (target.id > 0) UnloadRenderTexture(target);
+    target = {0};
+    valid = false;
+  }
+};
+
+// Bump-pointer allocator. Allocations are never freed one by one, the whole
+// arena is reset at once, e.g. every step or every shot.
+struct Arena {
+  unsigned char* memory;
+  size_t capacity;
+  size_t used = 0;
+  size_t highWaterMark = 0;
+  int failedAllocations = 0;
+
+  Arena(size_t capacity)
+    : memory(new unsigned char[capacity]), capacity(capacity) {
+    poison(0, capacity);
+  }
+  ~Arena() { delete[] memory; }
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // Returns nullptr when the arena is full
+  void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    size_t start = (used + alignment - 1) & ~(alignment - 1);
+    if (start + size > capacity) {
+      failedAllocations++;
+      return nullptr;
+    }
+
+    used = start + size;
+    highWaterMark = std::max(highWaterMark, used);
+    return memory + start;
+  }
+
+  // Destructors are never called, so only use this for trivial types
+  template <typename T>
+  T* allocateArray(int count) {
+    T* items = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    if (items == nullptr) return nullptr;
+
+    for (int i = 0; i < count; i++) {
+      new (&items[i]) T();
+    }
+    return items;
+  }
+
+  void reset() {
+    poison(0, used);
+    used = 0;
+  }
+
+  // Debug builds fill unused memory so reads after a reset stand out
+  void poison(size_t start, size_t size) {
+#ifndef NDEBUG
+    memset(memory + start, ARENA_POISON, size);
+#endif
+  }
+};
+
+// Lock-free queue between exactly one producer and one consumer thread.
+// One slot is kept empty to tell a full queue from an empty one.
+template <typename T, int Capacity>
+struct SpscQueue {
+  T items[Capacity];
+  alignas(64) std::atomic<int> head{0};  // Next slot to read, consumer owned
+  alignas(64) std::atomic<int> tail{0};  // Next slot to write, producer owned
+
+  bool push(const T& item) {
+    int currentTail = tail.load(std::memory_order_relaxed);
+    int nextTail = (currentTail + 1) % Capacity;
+    if (nextTail == head.load(std::memory_order_acquire)) return false;
+
+    items[currentTail] = item;
+    tail.store(nextTail, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& item) {
+    int currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead == tail.load(std::memory_order_acquire)) return false;
+
+    item = items[currentHead];
+    head.store((currentHead + 1) % Capacity, std::memory_order_release);
+    return true;
+  }
+};
+
+// Publishes a value from one writer to any number of readers without locks.
+// The value is stored as atomic words, readers copy it and retry if the writer
+// published in the meantime, so the writer never waits on a reader.
+template <typename T>
+struct SeqLock {
+  static_assert(std::is_trivially_copyable<T>::value, "T is copied as words");
+  static const int WORD_COUNT =
+    (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  std::atomic<unsigned> sequence{0};  // Odd while a write is in progress
+  std::atomic<uint64_t> words[WORD_COUNT] = {};
+
+  void write(const T& value) {
+    uint64_t buffer[WORD_COUNT] = {};
+    memcpy(buffer, &value, sizeof(T));
+
+    unsigned current = sequence.load(std::memory_order_relaxed);
+    sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int w = 0; w < WORD_COUNT; w++) {
+      words[w].store(buffer[w], std::memory_order_relaxed);
+    }
+    sequence.store(current + 2, std::memory_order_release);
+  }
+
+  void read(T& value) const {
+    uint64_t buffer[WORD_COUNT];
+    unsigned before, after;
+    do {
+      before = sequence.load(std::memory_order_acquire);
+      for (int w = 0; w < WORD_COUNT; w++) {
+        buffer[w] = words[w].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+    memcpy(&value, buffer, sizeof(T));
+  }
+};
+
+enum ContactState { CONTACT_NONE, CONTACT_BEGIN, CONTACT_PERSIST, CONTACT_END };
+
+enum CollisionType { COLLISION_BALL, COLLISION_CUSHION, COLLISION_POCKET };
+
+struct CollisionEvent {
+  CollisionType type;
+  ContactState contact;  // Only set for ball-ball collisions
+  int a;                 // Ball index
+  int b;                 // Other ball or hole index, -1 for cushions
+  float speed;           // Relative speed at impact
+  float impulse;
+};
+
+// Preallocated buffer the physics step writes collision events into.
+// Consumers drain it after the step, events past the capacity are dropped.
+struct CollisionEvents {
+  CollisionEvent* events = nullptr;
+  int capacity = 0;
+  int count = 0;
+  int dropped = 0;
+
+  // Takes new storage from the arena, the old one goes away with its reset
+  void allocate(Arena& arena, int eventCapacity) {
+    events = arena.allocateArray<CollisionEvent>(eventCapacity);
+    capacity = (events != nullptr) ? eventCapacity : 0;
+    count = 0;
+    dropped = 0;
+  }
+
+  void push(CollisionEvent event) {
+    if (count < capacity)
+      events[count++] = event;
+    else
+      dropped++;
+  }
+};
+
+// Tracks touching ball pairs across physics steps so that side effects (like
+// the hit sound) only fire when a contact begins, not on every step it lasts
+struct ContactCache {
+  ContactState states[BALL_COUNT][BALL_COUNT] = {};
+  bool touched[BALL_COUNT][BALL_COUNT] = {};  // Touched during this step
+
+  // Pairs are unordered, so (a, b) and (b, a) share the same entry.
+  // Only the first touch of a pair in a step can return CONTACT_BEGIN.
+  ContactState touch(int a, int b) {
+    if (a > b) std::swap(a, b);
+    if (touched[a][b]) return CONTACT_PERSIST;
+
+    touched[a][b] = true;
+    if (states[a][b] == CONTACT_BEGIN || states[a][b] == CONTACT_PERSIST)
+      states[a][b] = CONTACT_PERSIST;
+    else
+      states[a][b] = CONTACT_BEGIN;
+    return states[a][b];
+  }
+
+  // Pairs not touched during the step end and report it, ended pairs go
+  // back to none
+  void endStep(CollisionEvents& events) {
+    for (int a = 0; a < BALL_COUNT; a++) {
+      for (int b = a + 1; b < BALL_COUNT; b++) {
+        if (!touched[a][b]) {
+          if (states[a][b] == CONTACT_BEGIN || states[a][b] == CONTACT_PERSIST) {
+            states[a][b] = CONTACT_END;
+            events.push({COLLISION_BALL, CONTACT_END, a, b, 0.0f, 0.0f});
+          } else {
+            states[a][b] = CONTACT_NONE;
+          }
+        }
+        touched[a][b] = false;
+      }
+    }
+  }
+
+  void clear() { *this = ContactCache(); }
+};
+
+// Every collision of the current shot, for replays and scoring
+struct ShotLog {
+  CollisionEvent* events = nullptr;
+  int capacity = 0;
+  int count = 0;
+
+  void begin(Arena& arena, int eventCapacity) {
+    events = arena.allocateArray<CollisionEvent>(eventCapacity);
+    capacity = (events != nullptr) ? eventCapacity : 0;
+    count = 0;
+  }
+
+  void record(CollisionEvents& stepEvents) {
+    for (int e = 0; e < stepEvents.count && count < capacity; e++) {
+      events[count++] = stepEvents.events[e];
+    }
+  }
+};
+
 void drawTable(Hole* holes) {
   int holeRadius = HOLE_RADIUS;
 
@@ -99,17 +395,54 @@ void drawTable(Hole* holes) {
   );  // right
 
   // Draw holes
-  holes[0].setPosition(holeRadius, holeRadius);
-  holes[0].draw();
+  for (int h = 0; h < HOLE_COUNT; h++) {
+    holes[h].draw();
+  }
+}
 
-  holes[1].setPosition(WINDOW_WIDTH - holeRadius, holeRadius);
-  holes[1].draw();
+// Render counters of the last frame, on the bottom cushion
+void drawStats() {
+  rlDrawStats stats = rlGetDrawStats();
+  int x = HOLE_RADIUS + 5;
+  int y = WINDOW_HEIGHT - HOLE_RADIUS + 5;
+
+  DrawText(
+    TextFormat(
+      "%i fps  batches %i (forced %i)  draw calls %i  textures %i", GetFPS(),
+      stats.batches, stats.forcedBatches, stats.drawCalls, stats.textureChanges
+    ),
+    x, y, 10, RAYWHITE
+  );
+  DrawText(
+    TextFormat(
+      "vertices %i  uploaded %i bytes", stats.vertexCount, stats.uploadBytes
+    ),
+    x, y + 12, 10, RAYWHITE
+  );
+}
 
-  holes[2].setPosition(WINDOW_WIDTH - holeRadius, WINDOW_HEIGHT - holeRadius);
-  holes[2].draw();
+// All balls are drawn in one batch, a single quad each
+void drawBalls(Circle* balls) {
+  Vector2 centers[BALL_COUNT];
+  float radii[BALL_COUNT];
+  Color colors[BALL_COUNT];
 
+  for (int i = 0; i < BALL_COUNT; i++) {
+    centers[i] = balls[i].position;
+    radii[i] = balls[i].radius;
+    colors[i] = balls[i].color;
+  }
+
+  DrawCircleBatch(centers, radii, colors, BALL_COUNT);
+}
+
+void setupHoles(Hole* holes) {
+  int holeRadius = HOLE_RADIUS;
+
+  holes[0].setPosition(holeRadius, holeRadius);
+  holes[1].setPosition(WINDOW_WIDTH - holeRadius, holeRadius);
+  holes[2].setPosition(WINDOW_WIDTH - holeRadius, WINDOW_HEIGHT - holeRadius);
   holes[3].setPosition(holeRadius, WINDOW_HEIGHT - holeRadius);
-  holes[3].draw();
 }
 
 float getImpulse(
@@ -162,52 +495,491 @@ bool isGameOver(Circle* balls) {
   return true;
 }
 
-int main() {
-  // Setup balls
-  Circle* balls = new Circle[BALL_COUNT];
-  resetTable(balls);
+// Advances the simulation by one timestep. Side effects of collisions are
+// not handled here, they are pushed to events for consumers to drain.
+void stepPhysics(
+  Circle* balls, Hole* holes, Vector2 hitForce, float timestep,
+  ContactCache& contacts, CollisionEvents& events
+) {
+  Vector2 topWallClampedPoint, leftWallClampedPoint, rightWallClampedPoint,
+    bottomWallClampedPoint;
+  bool isColliding = false;
+
+  // Collision detection
+  for (int i = 0; i < BALL_COUNT; i++) {
+    // Collision between ball and wall
+
+    topWallClampedPoint = {
+      Clamp(balls[i].position.x, 70.0f, 800.f - 70.0f),
+      Clamp(balls[i].position.y, 0.0f, 35.0f)};
+    leftWallClampedPoint = {
+      Clamp(balls[i].position.x, 0.0f, 35.0f),
+      Clamp(balls[i].position.y, 70.0f, 600.0f - 70.0f)};
+    bottomWallClampedPoint = {
+      Clamp(balls[i].position.x, 70.0f, 800.0f - 70.0f),
+      Clamp(balls[i].position.y, 600.0f - 35.0f, 600.0f)};
+    rightWallClampedPoint = {
+      Clamp(balls[i].position.x, 800.0f - 35.0f, 800.0f),
+      Clamp(balls[i].position.y, 70.0f, 600 - 70.0f)};
+    Vector2 relativeVelocity =
+      Vector2Subtract(balls[i].velocity, {0.0f, 0.0f});
+
+    if (isColliding == false) {
+      if(Vector2Distance(topWallClampedPoint, balls[i].position) <= balls[i].radius){
+        isColliding = true;
+        // std::cout << "top Wall collided. Ball: " << i << std::endl;
+        Vector2 collisionNormal = {
+          balls[i].position.x - topWallClampedPoint.x,
+          balls[i].position.y - topWallClampedPoint.y};
+        float impulse =
+          getImpulseAABB(balls[i], relativeVelocity, collisionNormal);
+        balls[i].position.y += 2.0f;
+        balls[i].velocity = Vector2Add(
+          balls[i].velocity,
+          Vector2Scale(
+            Vector2Scale(collisionNormal, 1.0f / balls[i].mass), impulse
+          )
+        );
+        events.push(
+          {COLLISION_CUSHION, CONTACT_NONE, i, -1,
+           Vector2Length(relativeVelocity), impulse}
+        );
+        isColliding = false;
+      }
+      if(Vector2Distance(leftWallClampedPoint, balls[i].position) <= balls[i].radius){
+        isColliding = true;
+        // std::cout << "left Wall collided. Ball: " << i << std::endl;
+        Vector2 collisionNormal = {
+          balls[i].position.x - leftWallClampedPoint.x,
+          balls[i].position.y - leftWallClampedPoint.y};
+        float impulse =
+          getImpulseAABB(balls[i], relativeVelocity, collisionNormal);
+        balls[i].position.x += 2.0f;
+        balls[i].velocity = Vector2Add(
+          balls[i].velocity,
+          Vector2Scale(
+            Vector2Scale(collisionNormal, 1.0f / balls[i].mass), impulse
+          )
+        );
+        events.push(
+          {COLLISION_CUSHION, CONTACT_NONE, i, -1,
+           Vector2Length(relativeVelocity), impulse}
+        );
+        isColliding = false;
+      }
+      if(Vector2Distance(rightWallClampedPoint, balls[i].position) <= balls[i].radius){
+        isColliding = true;
+        // std::cout << "right Wall collided. Ball: " << i << std::endl;
+        Vector2 collisionNormal = {
+          balls[i].position.x - rightWallClampedPoint.x,
+          balls[i].position.y - rightWallClampedPoint.y};
+        float impulse =
+          getImpulseAABB(balls[i], relativeVelocity, collisionNormal);
+        balls[i].position.x -= 2.0f;
+        balls[i].velocity = Vector2Add(
+          balls[i].velocity,
+          Vector2Scale(
+            Vector2Scale(collisionNormal, 1.0f / balls[i].mass), impulse
+          )
+        );
+        events.push(
+          {COLLISION_CUSHION, CONTACT_NONE, i, -1,
+           Vector2Length(relativeVelocity), impulse}
+        );
+        isColliding = false;
+      }
+      if(Vector2Distance(bottomWallClampedPoint, balls[i].position) <= balls[i].radius){
+        isColliding = true;
+        // std::cout << "bottom Wall collided. Ball: " << i << std::endl;
+        Vector2 collisionNormal = {
+          balls[i].position.x - bottomWallClampedPoint.x,
+          balls[i].position.y - bottomWallClampedPoint.y};
+        float impulse =
+          getImpulseAABB(balls[i], relativeVelocity, collisionNormal);
+        balls[i].position.y -= 2.0f;
+        balls[i].velocity = Vector2Add(
+          balls[i].velocity,
+          Vector2Scale(
+            Vector2Scale(collisionNormal, 1.0f / balls[i].mass), impulse
+          )
+        );
+        events.push(
+          {COLLISION_CUSHION, CONTACT_NONE, i, -1,
+           Vector2Length(relativeVelocity), impulse}
+        );
+        isColliding = false;
+      }
+    }
 
-  // Setup cue
-  Circle* cue = &balls[0];
-  cue->color = WHITE;
+    // Collision detection between balls and holes
+    // Checks if a ball is mostly in the hole
+    for (int h = 0; h < HOLE_COUNT; h++) {
+      Circle* ball = &balls[i];
+      Hole* hole = &holes[h];
 
-  // Setup holes
-  Hole* holes = new Hole[HOLE_COUNT];
+      if (!ball->active) continue;
+
+      float sumOfRadii(pow(BALL_RADIUS + (HOLE_RADIUS / 2), 2));
+      float distanceBetweenCenters(
+        Vector2DistanceSqr(ball->position, hole->position)
+      );
+
+      if (sumOfRadii >= distanceBetweenCenters) {
+        events.push(
+          {COLLISION_POCKET, CONTACT_NONE, i, h, Vector2Length(ball->velocity),
+           0.0f}
+        );
+      }
+    }
 
-  bool gameOver(false);
-  bool isPlayersTurn(false);
+    // Collision between 2 balls
+    for (int j = 0; j < BALL_COUNT; j++) {
+      if (j == i) continue;
+
+      Circle* a = &balls[i];
+      Circle* b = &balls[j];
+
+      if (!a->active || !b->active) continue;
+
+      float sumOfRadii(pow(BALL_RADIUS * 2, 2));
+      float distanceBetweenCenters(
+        Vector2DistanceSqr(a->position, b->position)
+      );
+
+      // Collision detected
+      if (sumOfRadii >= distanceBetweenCenters) {
+        ContactState contact = contacts.touch(i, j);
+
+        Vector2 collisionNormalAB(
+          {b->position.x - a->position.x, b->position.y - a->position.y}
+        );
+        Vector2 relativeVelocityAB(Vector2Subtract(a->velocity, b->velocity)
+        );
+        Vector2 collisionNormalABNormalized(
+          Vector2Normalize(collisionNormalAB)
+        );
+        Vector2 relativeVelocityABNormalized(
+          Vector2Normalize(relativeVelocityAB)
+        );
+
+        // I think we should also separate balls that are touching
+        if (Vector2Length(relativeVelocityAB) <= 0.1f) {
+          a->position = Vector2Subtract(
+            a->position, Vector2Scale(collisionNormalABNormalized, 0.5f)
+          );
+          b->position = Vector2Add(
+            b->position, Vector2Scale(collisionNormalABNormalized, 0.5f)
+          );
+        }
+
+        // Collision response
+        // Check dot product between collision normal and relative velocity
+        float impulse(0.0f);
+        if (Vector2DotProduct(relativeVelocityABNormalized, collisionNormalABNormalized) > 0) {
+          impulse =
+            getImpulse(*a, *b, relativeVelocityAB, collisionNormalAB);
+          a->velocity = Vector2Add(
+            a->velocity,
+            Vector2Scale(
+              Vector2Scale(collisionNormalAB, 1.0f / a->mass), impulse
+            )
+          );
+          b->velocity = Vector2Subtract(
+            b->velocity,
+            Vector2Scale(
+              Vector2Scale(collisionNormalAB, 1.0f / b->mass), impulse
+            )
+          );
+        }
+
+        // Both (i, j) and (j, i) are visited, only report the pair once
+        if (i < j) {
+          events.push(
+            {COLLISION_BALL, contact, i, j, Vector2Length(relativeVelocityAB),
+             impulse}
+          );
+        }
+      }
+    }
+  }
+
+  // Movement
+  balls[0].update(hitForce, timestep);
+  for (int i = 1; i < BALL_COUNT; i++) {
+    balls[i].update({0.0f, 0.0f}, timestep);
+  }
+  contacts.endStep(events);
+}
+
+// Stereo placement of a sound played at a point on the table
+struct SoundPlacement {
+  float pan = 0.5f;
+  float attenuation = 1.0f;
+};
+
+// Pan follows the point across the table and volume falls off with its
+// distance to the center. The mixer ramps both, so moving sources don't click.
+SoundPlacement placeSound(Vector2 point) {
+  Vector2 center = {WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f};
+  float distance = Vector2Distance(point, center) / Vector2Length(center);
+
+  SoundPlacement placement;
+  // raylib pans from 1.0 (left) to 0.0 (right)
+  placement.pan = Clamp(
+    0.5f - SOUND_PAN_SPREAD * (point.x - center.x) / WINDOW_WIDTH, 0.0f, 1.0f
+  );
+  placement.attenuation =
+    1.0f - SOUND_DISTANCE_ATTENUATION * Clamp(distance, 0.0f, 1.0f);
+  return placement;
+}
+
+// Merges triggers of one sound into a single voice per window. The first
+// trigger plays right away, later ones in the window are held back and
+// played once when it closes, at the loudest volume among them and from
+// where that one happened.
+struct SoundCoalescer {
+  Sound sound;
+  float window;
+  float elapsed;
+  float pendingVolume = 0.0f;
+  float pendingPan = 0.5f;
+  bool pending = false;
+
+  SoundCoalescer(Sound sound, float window)
+      : sound(sound), window(window), elapsed(window) {}
+
+  void trigger(float volume, float pan) {
+    if (elapsed >= window) {
+      play(volume, pan);
+    } else if (!pending || volume > pendingVolume) {
+      pendingVolume = volume;
+      pendingPan = pan;
+      pending = true;
+    }
+  }
+
+  void update(float timestep) {
+    elapsed += timestep;
+    if (pending && elapsed >= window) {
+      play(pendingVolume, pendingPan);
+      pending = false;
+    }
+  }
+
+  void play(float volume, float pan) {
+    SetSoundVolume(sound, volume);
+    SetSoundPan(sound, pan);
+    PlaySoundMulti(sound);
+    elapsed = 0.0f;
+  }
+};
+
+void playCollisionSounds(
+  CollisionEvents& events, Circle* balls, SoundCoalescer& ballHits
+) {
+  for (int e = 0; e < events.count; e++) {
+    CollisionEvent& event = events.events[e];
+
+    // Only play the hit sound once per contact, not on every step it persists
+    if (event.type != COLLISION_BALL || event.contact != CONTACT_BEGIN)
+      continue;
+
+    // Set hit sound volume depending on strength of hit, louder hits win voices
+    float volume = Remap(event.speed, 200.0f, 1000.0f, 0.0f, 1.0f);
+
+    // Heard from the contact point, halfway between both balls
+    SoundPlacement placement = placeSound(
+      Vector2Lerp(balls[event.a].position, balls[event.b].position, 0.5f)
+    );
+    ballHits.trigger(volume * placement.attenuation, placement.pan);
+  }
+}
+
+void pocketBalls(CollisionEvents& events, Circle* balls, bool& gameOver) {
+  for (int e = 0; e < events.count; e++) {
+    CollisionEvent& event = events.events[e];
+    if (event.type != COLLISION_POCKET) continue;
+
+    Circle* ball = &balls[event.a];
+    if (ball == &balls[0]) {
+      ball->velocity = {0, 0};
+      ball->position = CUE_START_POSITION;
+    } else {
+      ball->setInactive();
+      if (isGameOver(balls)) gameOver = true;
+    }
+  }
+}
+
+enum CommandType { COMMAND_HIT, COMMAND_RESET };
+
+// Input sent from the main thread to the simulation thread
+struct Command {
+  CommandType type;
+  Vector2 force = {0.0f, 0.0f};
+};
+
+// What the main thread needs from the simulation to draw a frame
+struct WorldSnapshot {
+  Circle balls[BALL_COUNT];
+  bool isPlayersTurn = false;
+  bool gameOver = false;
+};
+
+// Owns the balls and runs the physics at a fixed rate on its own thread.
+// The main thread only talks to it through the command queue and the
+// published world, which always holds the latest state of the table.
+struct Simulation {
+  Circle balls[BALL_COUNT];
+  Hole* holes;
+  SoundCoalescer ballHits;
+
+  ContactCache contacts;
+  CollisionEvents events;
+  ShotLog shotLog;
+  bool gameOver = false;
+
+  // Temporaries live in arenas so a step does no heap allocations
+  Arena stepArena{STEP_ARENA_SIZE};
+  Arena shotArena{SHOT_ARENA_SIZE};
+
+  // A hit used to push the cue for one frame, keep it for as long
+  Vector2 hitForce = {0.0f, 0.0f};
+  int hitStepsLeft = 0;
+
+  SpscQueue<Command, COMMAND_QUEUE_SIZE> commands;
+  SeqLock<WorldSnapshot> world;
+  std::atomic<bool> running{true};
+
+  Simulation(Hole* holes, Sound ballHit)
+      : holes(holes), ballHits(ballHit, SOUND_COALESCE_WINDOW) {
+    resetTable(balls);
+    balls[0].color = WHITE;  // Cue
+    startShot();
+  }
+
+  void startShot() {
+    shotArena.reset();
+    shotLog.begin(shotArena, MAX_SHOT_EVENTS);
+  }
+
+  void handleCommands() {
+    Command command;
+    while (commands.pop(command)) {
+      switch (command.type) {
+        case COMMAND_HIT:
+          hitForce = command.force;
+          hitStepsLeft = SIMULATION_RATE / TARGET_FPS;
+          startShot();
+          break;
+        case COMMAND_RESET:
+          resetTable(balls);
+          contacts.clear();
+          gameOver = false;
+          startShot();
+          break;
+      }
+    }
+  }
+
+  void step() {
+    Vector2 force = (hitStepsLeft > 0) ? hitForce : Vector2{0.0f, 0.0f};
+    if (hitStepsLeft > 0) hitStepsLeft--;
+
+    stepArena.reset();
+    events.allocate(stepArena, MAX_COLLISION_EVENTS);
+
+    stepPhysics(balls, holes, force, SIMULATION_TIMESTEP, contacts, events);
+    playCollisionSounds(events, balls, ballHits);
+    ballHits.update(SIMULATION_TIMESTEP);
+    pocketBalls(events, balls, gameOver);
+    shotLog.record(events);
+  }
+
+  void publish() {
+    WorldSnapshot snapshot;
+    snapshot.isPlayersTurn = true;
+    for (int i = 0; i < BALL_COUNT; i++) {
+      snapshot.balls[i] = balls[i];
+      if (balls[i].isMoving()) snapshot.isPlayersTurn = false;
+    }
+    snapshot.gameOver = gameOver;
+
+    // Each step replaces the last one, a renderer that fell behind skips
+    // straight to the newest state instead of working through old ones
+    world.write(snapshot);
+  }
+
+  void run() {
+    std::chrono::steady_clock::duration stepDuration =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(SIMULATION_TIMESTEP)
+      );
+    std::chrono::steady_clock::time_point nextStep =
+      std::chrono::steady_clock::now();
+
+    while (running.load(std::memory_order_relaxed)) {
+      handleCommands();
+      step();
+      publish();
+
+      // Steps that are late run back to back until the thread catches up
+      nextStep += stepDuration;
+      std::this_thread::sleep_until(nextStep);
+    }
+  }
+};
+
+int main() {
+  // Everything that lives as long as the table
+  Arena tableArena(TABLE_ARENA_SIZE);
+
+  // Setup holes
+  Hole* holes = tableArena.allocateArray<Hole>(HOLE_COUNT);
+  setupHoles(holes);
 
   bool mouseStartedDragging(false);
+  bool showStats(false);
   Vector2 mouseDragStartPosition;
   Vector2 mousePosition;
 
-  Vector2 hitForce({0.0f, 0.0f});  // Force when releasing mouse to hit cue ball
-
-  float accumulator(0.0f);
-  float deltaTime;
-
   // Sounds
   InitAudioDevice();
   Sound ballHit = LoadSound("ball_hit.wav");
+  SetSoundMaxVoices(ballHit, BALL_HIT_MAX_VOICES);
+
+  // Physics, also sets up the balls
+  Simulation simulation(holes, ballHit);
+  simulation.publish();  // So there is a snapshot to draw on the first frame
+  std::thread simulationThread(&Simulation::run, &simulation);
+
+  WorldSnapshot* world = tableArena.allocateArray<WorldSnapshot>(1);
 
   InitWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Physics, Collision");
   SetTargetFPS(TARGET_FPS);
+
+  // The table never changes, it is only drawn again on resize
+  BackgroundCache tableCache;
+
+  rlEnableDrawSorting();
+
   while (!WindowShouldClose()) {
-    deltaTime = GetFrameTime();
+    // Balls and game state are read together so the frame is consistent
+    simulation.world.read(*world);
+    bool isPlayersTurn = world->isPlayersTurn;
+    bool gameOver = world->gameOver;
+
+    if (tableCache.begin()) {
+      drawTable(holes);
+      tableCache.end();
+    }
 
     BeginDrawing();
     ClearBackground(WHITE);
 
-    drawTable(holes);
-
-    isPlayersTurn = true;
-    // Check if balls aren't moving
-    for (int i = 0; i < BALL_COUNT; i++) {
-      if (balls[i].isMoving()) {
-        isPlayersTurn = false;
-        break;
-      }
-    }
+    rlSetDrawLayer(TABLE_LAYER);
+    tableCache.draw();
+    rlSetDrawLayer(UI_LAYER);
 
     if (isPlayersTurn)
       DrawText(
@@ -216,10 +988,11 @@ int main() {
 
     // Input
     if (IsKeyPressed(KEY_R) && isPlayersTurn) {
-      resetTable(balls);
-			gameOver = false;
+      simulation.commands.push({COMMAND_RESET});
     }
 
+    if (IsKeyPressed(KEY_F1)) showStats = !showStats;
+
     if (!gameOver) {
       mousePosition = GetMousePosition();
       if (IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
@@ -234,223 +1007,23 @@ int main() {
           }
         }
       } else {
-        hitForce = {0.0f, 0.0f};
         if (mouseStartedDragging) {
           // Hit cue
-          hitForce = Vector2ClampValue(
+          Vector2 hitForce = Vector2ClampValue(
             Vector2Scale(
               (Vector2Subtract(mousePosition, mouseDragStartPosition)),
               -FORCE_MULTIPLIER
             ),
             0.0f, HITFORCE_LIMIT
           );
+          simulation.commands.push({COMMAND_HIT, hitForce});
           mouseStartedDragging = false;
         }
       }
     }
 
-    // Physics
-    accumulator += deltaTime;
-    Vector2 topWallClampedPoint, leftWallClampedPoint, rightWallClampedPoint,
-      bottomWallClampedPoint;
-    bool isColliding = false;
-    while (accumulator >= TIMESTEP) {
-      // Collision detection
-      for (int i = 0; i < BALL_COUNT; i++) {
-        // Collision between ball and wall
-
-        topWallClampedPoint = {
-          Clamp(balls[i].position.x, 70.0f, 800.f - 70.0f),
-          Clamp(balls[i].position.y, 0.0f, 35.0f)};
-        leftWallClampedPoint = {
-          Clamp(balls[i].position.x, 0.0f, 35.0f),
-          Clamp(balls[i].position.y, 70.0f, 600.0f - 70.0f)};
-        bottomWallClampedPoint = {
-          Clamp(balls[i].position.x, 70.0f, 800.0f - 70.0f),
-          Clamp(balls[i].position.y, 600.0f - 35.0f, 600.0f)};
-        rightWallClampedPoint = {
-          Clamp(balls[i].position.x, 800.0f - 35.0f, 800.0f),
-          Clamp(balls[i].position.y, 70.0f, 600 - 70.0f)};
-        Vector2 relativeVelocity =
-          Vector2Subtract(balls[i].velocity, {0.0f, 0.0f});
-
-        if (isColliding == false) {
-          if(Vector2Distance(topWallClampedPoint, balls[i].position) <= balls[i].radius){
-            isColliding = true;
-            // std::cout << "top Wall collided. Ball: " << i << std::endl;
-            Vector2 collisionNormal = {
-              balls[i].position.x - topWallClampedPoint.x,
-              balls[i].position.y - topWallClampedPoint.y};
-            float impulse =
-              getImpulseAABB(balls[i], relativeVelocity, collisionNormal);
-            balls[i].position.y += 2.0f;
-            balls[i].velocity = Vector2Add(
-              balls[i].velocity,
-              Vector2Scale(
-                Vector2Scale(collisionNormal, 1.0f / balls[i].mass), impulse
-              )
-            );
-            isColliding = false;
-          }
-          if(Vector2Distance(leftWallClampedPoint, balls[i].position) <= balls[i].radius){
-            isColliding = true;
-            // std::cout << "left Wall collided. Ball: " << i << std::endl;
-            Vector2 collisionNormal = {
-              balls[i].position.x - leftWallClampedPoint.x,
-              balls[i].position.y - leftWallClampedPoint.y};
-            float impulse =
-              getImpulseAABB(balls[i], relativeVelocity, collisionNormal);
-            balls[i].position.x += 2.0f;
-            balls[i].velocity = Vector2Add(
-              balls[i].velocity,
-              Vector2Scale(
-                Vector2Scale(collisionNormal, 1.0f / balls[i].mass), impulse
-              )
-            );
-            isColliding = false;
-          }
-          if(Vector2Distance(rightWallClampedPoint, balls[i].position) <= balls[i].radius){
-            isColliding = true;
-            // std::cout << "right Wall collided. Ball: " << i << std::endl;
-            Vector2 collisionNormal = {
-              balls[i].position.x - rightWallClampedPoint.x,
-              balls[i].position.y - rightWallClampedPoint.y};
-            float impulse =
-              getImpulseAABB(balls[i], relativeVelocity, collisionNormal);
-            balls[i].position.x -= 2.0f;
-            balls[i].velocity = Vector2Add(
-              balls[i].velocity,
-              Vector2Scale(
-                Vector2Scale(collisionNormal, 1.0f / balls[i].mass), impulse
-              )
-            );
-            isColliding = false;
-          }
-          if(Vector2Distance(bottomWallClampedPoint, balls[i].position) <= balls[i].radius){
-            isColliding = true;
-            // std::cout << "bottom Wall collided. Ball: " << i << std::endl;
-            Vector2 collisionNormal = {
-              balls[i].position.x - bottomWallClampedPoint.x,
-              balls[i].position.y - bottomWallClampedPoint.y};
-            float impulse =
-              getImpulseAABB(balls[i], relativeVelocity, collisionNormal);
-            balls[i].position.y -= 2.0f;
-            balls[i].velocity = Vector2Add(
-              balls[i].velocity,
-              Vector2Scale(
-                Vector2Scale(collisionNormal, 1.0f / balls[i].mass), impulse
-              )
-            );
-            isColliding = false;
-          }
-        }
-
-        // Collision detection between balls and holes
-        // Checks if a ball is mostly in the hole
-        for (int h = 0; h < HOLE_COUNT; h++) {
-          Circle* ball = &balls[i];
-          Hole* hole = &holes[h];
-
-          float sumOfRadii(pow(BALL_RADIUS + (HOLE_RADIUS / 2), 2));
-          float distanceBetweenCenters(
-            Vector2DistanceSqr(ball->position, hole->position)
-          );
-
-          if (sumOfRadii >= distanceBetweenCenters) {
-            if (ball == &balls[0]) {
-              ball->velocity = {0, 0};
-              ball->position = CUE_START_POSITION;
-            } else {
-              ball->setInactive();
-              if (isGameOver(balls)) {
-                gameOver = true;
-                continue;
-              }
-            }
-          }
-        }
-
-        // Collision between 2 balls
-        for (int j = 0; j < BALL_COUNT; j++) {
-          if (j == i) continue;
-
-          Circle* a = &balls[i];
-          Circle* b = &balls[j];
-
-          if (!a->active || !b->active) continue;
-
-          float sumOfRadii(pow(BALL_RADIUS * 2, 2));
-          float distanceBetweenCenters(
-            Vector2DistanceSqr(a->position, b->position)
-          );
-
-          // Collision detected
-          if (sumOfRadii >= distanceBetweenCenters) {
-            Vector2 collisionNormalAB(
-              {b->position.x - a->position.x, b->position.y - a->position.y}
-            );
-            Vector2 relativeVelocityAB(Vector2Subtract(a->velocity, b->velocity)
-            );
-            Vector2 collisionNormalABNormalized(
-              Vector2Normalize(collisionNormalAB)
-            );
-            Vector2 relativeVelocityABNormalized(
-              Vector2Normalize(relativeVelocityAB)
-            );
-
-            // I think we should also separate balls that are touching
-            if (Vector2Length(relativeVelocityAB) <= 0.1f) {
-              a->position = Vector2Subtract(
-                a->position, Vector2Scale(collisionNormalABNormalized, 0.5f)
-              );
-              b->position = Vector2Add(
-                b->position, Vector2Scale(collisionNormalABNormalized, 0.5f)
-              );
-            }
-
-            // Set hit sound volume depending on strength of hit
-            SetSoundVolume(
-              ballHit,
-              Remap(
-                Vector2Length(relativeVelocityAB), 200.0f, 1000.0f, 0.0f, 1.0f
-              )
-            );
-            PlaySoundMulti(ballHit);
-
-            // Collision response
-            // Check dot product between collision normal and relative velocity
-            if (Vector2DotProduct(relativeVelocityABNormalized, collisionNormalABNormalized) > 0) {
-              float impulse =
-                getImpulse(*a, *b, relativeVelocityAB, collisionNormalAB);
-              a->velocity = Vector2Add(
-                a->velocity,
-                Vector2Scale(
-                  Vector2Scale(collisionNormalAB, 1.0f / a->mass), impulse
-                )
-              );
-              b->velocity = Vector2Subtract(
-                b->velocity,
-                Vector2Scale(
-                  Vector2Scale(collisionNormalAB, 1.0f / b->mass), impulse
-                )
-              );
-            }
-          }
-        }
-      }
-
-      // Movement
-      cue->update(hitForce, TIMESTEP);
-      for (int i = 1; i < BALL_COUNT; i++) {
-        balls[i].update();
-      }
-      accumulator -= TIMESTEP;
-    }
-
     // Draw balls
-    for (int i = 0; i < BALL_COUNT; i++) {
-      balls[i].draw();
-    }
+    drawBalls(world->balls);
 
     if (gameOver) {
       DrawText(
@@ -459,14 +1032,17 @@ int main() {
       );
     }
 
+    if (showStats) drawStats();
+
     EndDrawing();
   }
 
-  delete cue;
-  delete[] balls;
-  delete[] holes;
+  simulation.running = false;
+  simulationThread.join();
+
   UnloadSound(ballHit);
 
+  tableCache.unload();
   CloseWindow();
   CloseAudioDevice();
   return 0;
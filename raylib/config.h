@@ -95,8 +95,11 @@
 // Show OpenGL extensions and capabilities detailed logs on init
 //#define RLGL_SHOW_GL_DETAILS_INFO              1
 
+// Orphan render batch buffers before update, avoids CPU-GPU sync stalls on batch upload
+#define RLGL_ORPHAN_BATCH_BUFFERS              1
+
 //#define RL_DEFAULT_BATCH_BUFFER_ELEMENTS    4096    // Default internal render batch elements limits
-#define RL_DEFAULT_BATCH_BUFFERS               1      // Default number of batch buffers (multi-buffering)
+#define RL_DEFAULT_BATCH_BUFFERS               3      // Default number of batch buffers (multi-buffering)
 #define RL_DEFAULT_BATCH_DRAWCALLS           256      // Default number of batch draw calls (by state changes: mode, texture)
 #define RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS     4      // Maximum number of textures units that can be activated on batch drawing (SetShaderValueTexture())
 
@@ -219,6 +222,10 @@
 #define AUDIO_DEVICE_SAMPLE_RATE           0    // Device sample rate (device default)
 
 #define MAX_AUDIO_BUFFER_POOL_CHANNELS    16    // Maximum number of audio pool channels
+#define MAX_AUDIO_ACTIVE_BUFFERS         256    // Maximum number of audio buffers playing at the same time
+#define AUDIO_COMMAND_QUEUE_SIZE         256    // Audio commands queue size, game thread to audio thread (power of two)
+#define MUSIC_DECODER_BUFFER_SECONDS       2    // Music stream decoded ahead of playback (seconds)
+#define MUSIC_DECODER_CHUNK_FRAMES      4096    // Music stream frames decoded at once
 
 //------------------------------------------------------------------------------------
 // Module: utils - Configuration Flags
@@ -175,6 +175,17 @@ typedef struct tagBITMAPINFOHEADER {
 #include <stdlib.h>                     // Required for: malloc(), free()
 #include <stdio.h>                      // Required for: FILE, fopen(), fclose(), fread()
 #include <string.h>                     // Required for: strcmp() [Used in IsFileExtension(), LoadWaveFromMemory(), LoadMusicStreamFromMemory()]
+#include <math.h>                       // Required for: sinf(), cosf() [Used in InitResamplerKernel()]
+
+// SIMD mixing kernels, selected at compile time
+// NOTE: AVX requires building with -mavx (or /arch:AVX), SSE is always available on x86-64
+#if defined(__AVX__)
+    #include <immintrin.h>              // Required for: AVX intrinsics [Used in MixAudioSamples(), ResampleFrame()]
+    #define AUDIO_MIX_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+    #include <xmmintrin.h>              // Required for: SSE intrinsics [Used in MixAudioSamples(), ResampleFrame()]
+    #define AUDIO_MIX_SSE
+#endif
 
 #if defined(RAUDIO_STANDALONE)
     #ifndef TRACELOG
@@ -263,6 +274,21 @@ typedef struct tagBITMAPINFOHEADER {
 #ifndef MAX_AUDIO_BUFFER_POOL_CHANNELS
     #define MAX_AUDIO_BUFFER_POOL_CHANNELS    16    // Audio pool channels
 #endif
+#ifndef MAX_AUDIO_ACTIVE_BUFFERS
+    #define MAX_AUDIO_ACTIVE_BUFFERS         256    // Maximum audio buffers playing at the same time
+#endif
+#ifndef MUSIC_DECODER_BUFFER_SECONDS
+    #define MUSIC_DECODER_BUFFER_SECONDS       2    // Music stream decoded ahead of playback (seconds)
+#endif
+#ifndef MUSIC_DECODER_CHUNK_FRAMES
+    #define MUSIC_DECODER_CHUNK_FRAMES      4096    // Music stream frames decoded at once
+#endif
+#ifndef AUDIO_COMMAND_QUEUE_SIZE
+    #define AUDIO_COMMAND_QUEUE_SIZE         256    // Audio commands queue size (must be a power of two)
+#endif
+
+#define RESAMPLER_SINC_TAPS                   16    // Windowed-sinc kernel length in frames (multiple of 4, SIMD)
+#define RESAMPLER_SINC_PHASES                256    // Windowed-sinc kernel fractional positions tabulated
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
@@ -303,6 +329,41 @@ typedef enum {
     AUDIO_BUFFER_USAGE_STREAM
 } AudioBufferUsage;
 
+// Sound cache entry
+// NOTE: Decoded and converted sound data shared by sounds loaded from the same file
+typedef struct SoundCacheEntry {
+    char *fileName;                 // Sound file name (cache key)
+    unsigned int sampleRate;        // Device sample rate data was converted to (cache key)
+    unsigned char *data;            // Sound data, device format and channels
+    unsigned int frameCount;        // Sound data frames count
+    int refCount;                   // Sounds sharing this data
+    struct SoundCacheEntry *next;   // Next cache entry
+} SoundCacheEntry;
+
+// Music decoder
+// NOTE: Music is decoded by the decoder thread into a ring buffer read by the audio thread
+typedef struct MusicDecoder {
+    Music music;                    // Music decoded (decoding context is shared with user copies)
+    ma_pcm_rb ring;                 // Decoded frames, written by decoder thread, read by audio thread
+    unsigned int framesDecoded;     // Music position of next decoded frame
+    ma_uint32 looping;              // Music looping, updated by PlayMusicStream() and UpdateMusicStream()
+    ma_uint32 finished;             // Music end reached, no more frames to decode (not looping)
+    ma_uint32 underruns;            // Audio thread reads that found not enough decoded frames
+    ma_uint32 refilling;            // Ring buffer emptied on play/stop/seek, being refilled (not an underrun)
+    struct MusicDecoder *next;      // Next music decoder
+} MusicDecoder;
+
+// Resampler state, miniaudio custom resampling backend
+// NOTE: Last RESAMPLER_SINC_TAPS input frames are kept twice in a row, so the window is always contiguous,
+// output frames are interpolated between the two frames at mode latency from the newest one (see GetResamplerLatency())
+typedef struct ResamplerState {
+    ma_uint32 channels;             // Resampled channels (converter picks the lowest of input and output)
+    float step;                     // Input frames advanced per output frame (sample rate ratio and pitch)
+    float position;                 // Output position after window middle frame, in input frames
+    ma_uint32 head;                 // Window start frame
+    float frames[2*RESAMPLER_SINC_TAPS*AUDIO_DEVICE_CHANNELS];  // Window frames (mirrored)
+} ResamplerState;
+
 // Audio buffer struct
 struct rAudioBuffer {
     ma_data_converter converter;    // Audio data converter
@@ -313,6 +374,9 @@ struct rAudioBuffer {
     float volume;                   // Audio buffer volume
     float pitch;                    // Audio buffer pitch
     float pan;                      // Audio buffer pan (0.0f to 1.0f)
+    int resampler;                  // Audio buffer resampler mode (AudioResampler)
+    float mixGain[2];               // Channel gains (volume and pan) at the end of last mix, next mix ramps from them
+    bool mixGainSet;                // Mix gains set, false until first mixed since it started playing
 
     bool playing;                   // Audio buffer state: AUDIO_PLAYING
     bool paused;                    // Audio buffer state: AUDIO_PAUSED
@@ -323,9 +387,19 @@ struct rAudioBuffer {
     unsigned int sizeInFrames;      // Total buffer size in frames
     unsigned int frameCursorPos;    // Frame cursor position
     unsigned int framesProcessed;   // Total frames processed in this buffer (required for play timing)
+    bool ending;                    // Audio buffer data ended, silence is read until resampler is flushed
+    unsigned int tailFrames;        // Silence frames still to read before stopping, while ending
 
     unsigned char *data;            // Data buffer, on music stream keeps filling
 
+    int poolIndex;                  // Multichannel pool voice index (-1 for regular buffers)
+    rAudioBuffer *source;           // Multichannel pool voice: sound buffer being played
+    int voiceCount;                 // Sound buffer: pool voices currently playing it
+    int maxVoices;                  // Sound buffer: maximum pool voices playing it (0 = unlimited)
+    int activeIndex;                // Index in active buffers array (-1 if not playing)
+    SoundCacheEntry *cacheEntry;    // Shared data cache entry (NULL if data is owned by buffer)
+    MusicDecoder *decoder;          // Music stream decoder, data is read from its ring buffer (NULL if not music)
+
     rAudioBuffer *next;             // Next audio buffer on the list
     rAudioBuffer *prev;             // Previous audio buffer on the list
 };
@@ -340,28 +414,92 @@ struct rAudioProcessor {
 
 #define AudioBuffer rAudioBuffer    // HACK: To avoid CoreAudio (macOS) symbol collision
 
+// Audio command type
+// NOTE: Commands are posted by the game thread and applied by the audio thread
+typedef enum {
+    AUDIO_COMMAND_PLAY = 0,         // Play buffer from the start
+    AUDIO_COMMAND_CONTINUE,         // Play buffer from current cursor position (music streams)
+    AUDIO_COMMAND_STOP,             // Stop buffer
+    AUDIO_COMMAND_PAUSE,            // Pause buffer
+    AUDIO_COMMAND_RESUME,           // Resume buffer
+    AUDIO_COMMAND_VOLUME,           // Set buffer volume
+    AUDIO_COMMAND_PITCH,            // Set buffer pitch
+    AUDIO_COMMAND_PAN,              // Set buffer pan
+    AUDIO_COMMAND_RESAMPLER,        // Set buffer resampler mode
+    AUDIO_COMMAND_PLAY_MULTI,       // Play buffer data on the multichannel buffer pool
+    AUDIO_COMMAND_MAX_VOICES,       // Set buffer maximum multichannel pool voices
+    AUDIO_COMMAND_STOP_VOICES,      // Stop multichannel pool voices playing buffer data
+    AUDIO_COMMAND_RESET_DECODER,    // Discard buffer music decoder ring buffer frames, move to decoder position
+    AUDIO_COMMAND_TRACK,            // Add buffer to the buffers list
+    AUDIO_COMMAND_UNTRACK,          // Remove buffer from the buffers list (and active buffers)
+    AUDIO_COMMAND_ATTACH_PROCESSOR, // Add processor at the end of buffer processors chain
+    AUDIO_COMMAND_DETACH_PROCESSOR  // Remove processor from buffer processors chain
+} AudioCommandType;
+
+// Audio command struct
+typedef struct AudioCommand {
+    int type;                       // Command type (AudioCommandType)
+    AudioBuffer *buffer;            // Target audio buffer
+    rAudioProcessor *processor;     // Processor to attach/detach
+    float value;                    // Volume, pitch, pan, resampler or max voices value
+} AudioCommand;
+
 // Audio data context
 typedef struct AudioData {
     struct {
         ma_context context;         // miniaudio context data
         ma_device device;           // miniaudio device
-        ma_mutex lock;              // miniaudio mutex lock
+        ma_mutex lock;              // miniaudio mutex lock (commands producers, never locked by audio thread)
         bool isReady;               // Check if audio device is ready
-        size_t pcmBufferSize;       // Pre-allocated buffer size
-        void *pcmBuffer;            // Pre-allocated buffer to read audio data from file/memory
+        bool isOffline;             // Offline device: no playback, mixed on demand with RenderAudioFrames()
     } System;
+    struct {
+        ma_thread thread;           // Music decoder thread
+        ma_mutex lock;              // Music decoders list and decoding contexts lock (never locked by audio thread)
+        ma_uint32 isRunning;        // Music decoder thread running
+        ma_uint32 wake;             // Music decoder thread requested to decode without waiting
+        MusicDecoder *first;        // Music decoders list
+    } Decoder;
     struct {
         AudioBuffer *first;         // Pointer to first AudioBuffer in the list
         AudioBuffer *last;          // Pointer to last AudioBuffer in the list
         int defaultSize;            // Default audio buffer size for audio streams
+        AudioBuffer *active[MAX_AUDIO_ACTIVE_BUFFERS];  // Playing buffers, the only ones visited by the mixer
+        int activeCount;            // Playing buffers count
     } Buffer;
     struct {
         unsigned int poolCounter;                               // AudioBuffer pointers pool counter
         AudioBuffer *pool[MAX_AUDIO_BUFFER_POOL_CHANNELS];      // Multichannel AudioBuffer pointers pool
         unsigned int channels[MAX_AUDIO_BUFFER_POOL_CHANNELS];  // AudioBuffer pool channels
+        float priority[MAX_AUDIO_BUFFER_POOL_CHANNELS];         // AudioBuffer pool channels priority (volume played at)
+        int freeVoices[MAX_AUDIO_BUFFER_POOL_CHANNELS];         // Free pool channels stack
+        int freeCount;                                          // Free pool channels count
     } MultiChannel;
+    struct {
+        SoundCacheEntry *first;     // Sound cache entries, see LoadSound()
+    } SoundCache;
+    struct {
+        float kernel[(RESAMPLER_SINC_PHASES + 1)*RESAMPLER_SINC_TAPS];  // Windowed-sinc weights per fractional position
+    } Resampler;
+    struct {
+        AudioCommand queue[AUDIO_COMMAND_QUEUE_SIZE];   // Commands ring buffer (single producer, single consumer)
+        ma_uint32 head;             // Commands posted counter, only written by game thread
+        ma_uint32 tail;             // Commands applied counter, only written by audio thread
+    } Command;
 } AudioData;
 
+// Resampler backend callbacks, required by resampler vtable
+static ma_result OnGetResamplerHeapSize(void *pUserData, const ma_resampler_config *pConfig, size_t *pHeapSizeInBytes);
+static ma_result OnInitResampler(void *pUserData, const ma_resampler_config *pConfig, void *pHeap, ma_resampling_backend **ppBackend);
+static void OnUninitResampler(void *pUserData, ma_resampling_backend *pBackend, const ma_allocation_callbacks *pAllocationCallbacks);
+static ma_result OnProcessResampler(void *pUserData, ma_resampling_backend *pBackend, const void *pFramesIn, ma_uint64 *pFrameCountIn, void *pFramesOut, ma_uint64 *pFrameCountOut);
+static ma_result OnSetResamplerRate(void *pUserData, ma_resampling_backend *pBackend, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut);
+static ma_uint64 OnGetResamplerInputLatency(void *pUserData, const ma_resampling_backend *pBackend);
+static ma_uint64 OnGetResamplerOutputLatency(void *pUserData, const ma_resampling_backend *pBackend);
+static ma_result OnGetResamplerRequiredInputFrameCount(void *pUserData, const ma_resampling_backend *pBackend, ma_uint64 outputFrameCount, ma_uint64 *pInputFrameCount);
+static ma_result OnGetResamplerExpectedOutputFrameCount(void *pUserData, const ma_resampling_backend *pBackend, ma_uint64 inputFrameCount, ma_uint64 *pOutputFrameCount);
+static ma_result OnResetResampler(void *pUserData, ma_resampling_backend *pBackend);
+
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
@@ -374,12 +512,55 @@ static AudioData AUDIO = {          // Global AUDIO context
     .Buffer.defaultSize = 0
 };
 
+static ma_resampling_backend_vtable resamplerVTable = {    // Audio buffers resampler, see ResamplerState
+    OnGetResamplerHeapSize,
+    OnInitResampler,
+    OnUninitResampler,
+    OnProcessResampler,
+    OnSetResamplerRate,
+    OnGetResamplerInputLatency,
+    OnGetResamplerOutputLatency,
+    OnGetResamplerRequiredInputFrameCount,
+    OnGetResamplerExpectedOutputFrameCount,
+    OnResetResampler
+};
+
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
 //----------------------------------------------------------------------------------
+static void InitAudioSystem(bool offline, ma_uint32 sampleRate);   // Initialize audio context, device and multichannel pool
 static void OnLog(void *pUserData, ma_uint32 level, const char *pMessage);
 static void OnSendAudioDataToDevice(ma_device *pDevice, void *pFramesOut, const void *pFramesInput, ma_uint32 frameCount);
 static void MixAudioFrames(float *framesOut, const float *framesIn, ma_uint32 frameCount, AudioBuffer *buffer);
+static void MixAudioSamples(float *samplesOut, const float *samplesIn, ma_uint32 sampleCount, float evenGain, float oddGain, float evenStep, float oddStep); // Accumulate samples scaled by ramped gain (SIMD)
+
+static void PushAudioCommand(int type, AudioBuffer *buffer, rAudioProcessor *processor, float value, bool wait); // Post command to audio thread
+static void WaitAudioCommands(void);                                // Wait for audio thread to apply posted commands
+static void ProcessAudioCommands(void);                             // Apply all posted commands (audio thread)
+static void ApplyAudioCommand(const AudioCommand *command);         // Apply one command
+static void ResetAudioBuffer(AudioBuffer *buffer);                  // Stop and rewind audio buffer (audio thread)
+static void StopAudioBufferVoices(AudioBuffer *buffer);             // Stop multichannel pool voices playing buffer data (audio thread)
+static void UpdateAudioBufferPitch(AudioBuffer *buffer, float pitch);   // Update audio buffer converter rate for pitch (audio thread)
+static void InitResamplerKernel(void);                              // Compute windowed-sinc resampler weights table
+static void PushResamplerFrame(ResamplerState *state, const float *frame);  // Add input frame to resampler window, oldest frame is dropped
+static void ResampleFrame(ResamplerState *state, int mode, float *frameOut);    // Interpolate output frame from resampler window (SIMD)
+static int GetResamplerLatency(int mode);                           // Get resampler mode latency in input frames
+static ma_uint32 ReadAudioBufferTail(AudioBuffer *buffer, ma_uint32 frameCount);  // Read silence flushing resampler after data end, stops buffer (audio thread)
+static void PlayAudioBufferMulti(AudioBuffer *source);              // Play source data on a multichannel pool buffer (audio thread)
+static int GetVoiceToSteal(AudioBuffer *source, float priority);    // Get lowest priority pool voice, -1 if all have higher priority (audio thread)
+static Sound LoadSoundFromCache(const char *fileName);              // Load sound sharing cached data, empty sound if not cached
+static void AddSoundToCache(const char *fileName, Sound sound);     // Add sound data to cache, sound shares it from now on
+static void ReleaseSoundCacheEntry(SoundCacheEntry *entry);         // Release one reference to cached sound data
+static void DetachSoundCacheData(AudioBuffer *buffer);              // Make buffer own its data, not shared anymore
+static ma_thread_result MA_THREADCALL MusicDecoderThread(void *pData); // Music decoder thread, keeps music ring buffers filled
+static void UpdateMusicDecoders(void);                              // Decode music ahead of playback for all playing music streams
+static void FillMusicDecoder(MusicDecoder *decoder);                // Decode music until decoder ring buffer is full
+static void ResetMusicDecoder(MusicDecoder *decoder, unsigned int position);  // Discard decoded frames, decoding continues from position
+static void ReadMusicStreamFrames(Music music, void *frames, unsigned int frameCount);  // Read music frames from decoding context, wraps at end
+static void RewindMusicStream(Music music);                         // Seek music decoding context to start
+static ma_uint32 ReadMusicDecoderFrames(AudioBuffer *audioBuffer, void *framesOut, ma_uint32 frameCount);  // Read decoded music frames (audio thread)
+static bool ActivateAudioBuffer(AudioBuffer *buffer);               // Add buffer to active buffers array, false if full (audio thread)
+static void DeactivateAudioBuffer(AudioBuffer *buffer);             // Remove buffer from active buffers array (audio thread)
 
 #if defined(RAUDIO_STANDALONE)
 static bool IsFileExtension(const char *fileName, const char *ext); // Check file extension
@@ -405,6 +586,7 @@ void ResumeAudioBuffer(AudioBuffer *buffer);
 void SetAudioBufferVolume(AudioBuffer *buffer, float volume);
 void SetAudioBufferPitch(AudioBuffer *buffer, float pitch);
 void SetAudioBufferPan(AudioBuffer *buffer, float pan);
+void SetAudioBufferResampler(AudioBuffer *buffer, int resampler);
 void TrackAudioBuffer(AudioBuffer *buffer);
 void UntrackAudioBuffer(AudioBuffer *buffer);
 
@@ -414,11 +596,29 @@ void UntrackAudioBuffer(AudioBuffer *buffer);
 // Initialize audio device
 void InitAudioDevice(void)
 {
+    InitAudioSystem(false, AUDIO_DEVICE_SAMPLE_RATE);
+}
+
+// Initialize offline audio device, no playback hardware is required
+// NOTE: Mixing does not run on its own, audio is rendered on demand with RenderAudioFrames()
+void InitAudioDeviceOffline(int sampleRate)
+{
+    InitAudioSystem(true, (sampleRate > 0)? (ma_uint32)sampleRate : 44100);
+}
+
+// Initialize audio context, device and multichannel buffers pool
+// NOTE: Offline mode uses miniaudio null backend and never starts the device,
+// mixing callback is called directly by RenderAudioFrames()
+static void InitAudioSystem(bool offline, ma_uint32 sampleRate)
+{
+    InitResamplerKernel();
+
     // Init audio context
     ma_context_config ctxConfig = ma_context_config_init();
     ma_log_callback_init(OnLog, NULL);
 
-    ma_result result = ma_context_init(NULL, 0, &ctxConfig, &AUDIO.System.context);
+    ma_backend nullBackend = ma_backend_null;
+    ma_result result = ma_context_init(offline? &nullBackend : NULL, offline? 1 : 0, &ctxConfig, &AUDIO.System.context);
     if (result != MA_SUCCESS)
     {
         TRACELOG(LOG_WARNING, "AUDIO: Failed to initialize context");
@@ -434,7 +634,7 @@ void InitAudioDevice(void)
     config.capture.pDeviceID = NULL;  // NULL for the default capture AUDIO.System.device.
     config.capture.format = ma_format_s16;
     config.capture.channels = 1;
-    config.sampleRate = AUDIO_DEVICE_SAMPLE_RATE;
+    config.sampleRate = sampleRate;
     config.dataCallback = OnSendAudioDataToDevice;
     config.pUserData = NULL;
 
@@ -446,32 +646,58 @@ void InitAudioDevice(void)
         return;
     }
 
-    // Keep the device running the whole time. May want to consider doing something a bit smarter and only have the device running
-    // while there's at least one sound being played.
-    result = ma_device_start(&AUDIO.System.device);
-    if (result != MA_SUCCESS)
+    // Mixing happens on a seperate thread which means we need to synchronize. The audio thread never locks: the game thread
+    // posts commands into a lock-free queue applied at the start of every mixing callback, this mutex only serializes
+    // game-side threads posting commands
+    if (ma_mutex_init(&AUDIO.System.lock) != MA_SUCCESS)
     {
-        TRACELOG(LOG_WARNING, "AUDIO: Failed to start playback device");
+        TRACELOG(LOG_WARNING, "AUDIO: Failed to create mutex for mixing");
         ma_device_uninit(&AUDIO.System.device);
         ma_context_uninit(&AUDIO.System.context);
         return;
     }
 
-    // Mixing happens on a seperate thread which means we need to synchronize. I'm using a mutex here to make things simple, but may
-    // want to look at something a bit smarter later on to keep everything real-time, if that's necessary.
-    if (ma_mutex_init(&AUDIO.System.lock) != MA_SUCCESS)
+    if (ma_mutex_init(&AUDIO.Decoder.lock) != MA_SUCCESS)
     {
-        TRACELOG(LOG_WARNING, "AUDIO: Failed to create mutex for mixing");
+        TRACELOG(LOG_WARNING, "AUDIO: Failed to create mutex for music decoding");
+        ma_mutex_uninit(&AUDIO.System.lock);
         ma_device_uninit(&AUDIO.System.device);
         ma_context_uninit(&AUDIO.System.context);
         return;
     }
 
     // Init dummy audio buffers pool for multichannel sound playing
+    // NOTE: Device is not started yet, buffers are tracked directly
     for (int i = 0; i < MAX_AUDIO_BUFFER_POOL_CHANNELS; i++)
     {
         // WARNING: An empty audio buffer is created (data = 0) and added to list, AudioBuffer data is filled on PlaySoundMulti()
         AUDIO.MultiChannel.pool[i] = LoadAudioBuffer(AUDIO_DEVICE_FORMAT, AUDIO_DEVICE_CHANNELS, AUDIO.System.device.sampleRate, 0, AUDIO_BUFFER_USAGE_STATIC);
+        if (AUDIO.MultiChannel.pool[i] != NULL) AUDIO.MultiChannel.pool[i]->poolIndex = i;
+    }
+
+    // Init free voices stack, voices are popped in ascending order
+    AUDIO.MultiChannel.freeCount = 0;
+    for (int i = MAX_AUDIO_BUFFER_POOL_CHANNELS - 1; i >= 0; i--)
+    {
+        if (AUDIO.MultiChannel.pool[i] != NULL)
+        {
+            AUDIO.MultiChannel.freeVoices[AUDIO.MultiChannel.freeCount] = i;
+            AUDIO.MultiChannel.freeCount++;
+        }
+    }
+
+    // Keep the device running the whole time. May want to consider doing something a bit smarter and only have the device running
+    // while there's at least one sound being played.
+    if (!offline) result = ma_device_start(&AUDIO.System.device);
+    if (result != MA_SUCCESS)
+    {
+        TRACELOG(LOG_WARNING, "AUDIO: Failed to start playback device");
+        for (int i = 0; i < MAX_AUDIO_BUFFER_POOL_CHANNELS; i++) UnloadAudioBuffer(AUDIO.MultiChannel.pool[i]);
+        ma_mutex_uninit(&AUDIO.Decoder.lock);
+        ma_mutex_uninit(&AUDIO.System.lock);
+        ma_device_uninit(&AUDIO.System.device);
+        ma_context_uninit(&AUDIO.System.context);
+        return;
     }
 
     TRACELOG(LOG_INFO, "AUDIO: Device initialized successfully");
@@ -481,7 +707,21 @@ void InitAudioDevice(void)
     TRACELOG(LOG_INFO, "    > Sample rate:   %d -> %d", AUDIO.System.device.sampleRate, AUDIO.System.device.playback.internalSampleRate);
     TRACELOG(LOG_INFO, "    > Periods size:  %d", AUDIO.System.device.playback.internalPeriodSizeInFrames*AUDIO.System.device.playback.internalPeriods);
 
+    AUDIO.System.isOffline = offline;
     AUDIO.System.isReady = true;
+
+    // Music streams are decoded ahead of playback on their own thread, independent of frame rate
+    // NOTE: Offline device decodes music on RenderAudioFrames(), in step with mixing
+    if (!offline)
+    {
+        c89atomic_store_explicit_32(&AUDIO.Decoder.isRunning, 1, c89atomic_memory_order_release);
+
+        if (ma_thread_create(&AUDIO.Decoder.thread, ma_thread_priority_default, 0, MusicDecoderThread, NULL, NULL) != MA_SUCCESS)
+        {
+            TRACELOG(LOG_WARNING, "AUDIO: Failed to create music decoder thread, music decoded on UpdateMusicStream()");
+            c89atomic_store_explicit_32(&AUDIO.Decoder.isRunning, 0, c89atomic_memory_order_release);
+        }
+    }
 }
 
 // Close the audio device for all contexts
@@ -489,6 +729,19 @@ void CloseAudioDevice(void)
 {
     if (AUDIO.System.isReady)
     {
+        // Stop music decoder thread
+        if (c89atomic_load_explicit_32(&AUDIO.Decoder.isRunning, c89atomic_memory_order_acquire))
+        {
+            c89atomic_store_explicit_32(&AUDIO.Decoder.isRunning, 0, c89atomic_memory_order_release);
+            ma_thread_wait(&AUDIO.Decoder.thread);
+        }
+
+        // Stop audio thread and apply any command still pending,
+        // from now on commands are applied directly by the calling thread
+        ma_device_uninit(&AUDIO.System.device);
+        ProcessAudioCommands();
+        AUDIO.System.isReady = false;
+
         // Unload dummy audio buffers pool
         // WARNING: They can be pointing to already unloaded data
         for (int i = 0; i < MAX_AUDIO_BUFFER_POOL_CHANNELS; i++)
@@ -496,19 +749,21 @@ void CloseAudioDevice(void)
             //UnloadAudioBuffer(AUDIO.MultiChannel.pool[i]);
             if (AUDIO.MultiChannel.pool[i] != NULL)
             {
-                ma_data_converter_uninit(&AUDIO.MultiChannel.pool[i]->converter, NULL);
                 UntrackAudioBuffer(AUDIO.MultiChannel.pool[i]);
+                ma_data_converter_uninit(&AUDIO.MultiChannel.pool[i]->converter, NULL);
                 //RL_FREE(buffer->data);    // Already unloaded by UnloadSound()
                 RL_FREE(AUDIO.MultiChannel.pool[i]);
+                AUDIO.MultiChannel.pool[i] = NULL;
             }
         }
 
+        AUDIO.MultiChannel.freeCount = 0;
+
+        ma_mutex_uninit(&AUDIO.Decoder.lock);
         ma_mutex_uninit(&AUDIO.System.lock);
-        ma_device_uninit(&AUDIO.System.device);
         ma_context_uninit(&AUDIO.System.context);
 
-        AUDIO.System.isReady = false;
-        RL_FREE(AUDIO.System.pcmBuffer);
+        AUDIO.System.isOffline = false;
 
         TRACELOG(LOG_INFO, "AUDIO: Device closed successfully");
     }
@@ -527,6 +782,63 @@ void SetMasterVolume(float volume)
     ma_device_set_master_volume(&AUDIO.System.device, volume);
 }
 
+// Render audio mix into frames buffer, faster than real time (offline audio device only)
+// NOTE: Frames are float-32bit, AUDIO_DEVICE_CHANNELS interleaved, at the offline device sample rate
+void RenderAudioFrames(float *frames, int frameCount)
+{
+    if (!AUDIO.System.isReady || !AUDIO.System.isOffline)
+    {
+        TRACELOG(LOG_WARNING, "AUDIO: Rendering requires an offline audio device");
+        return;
+    }
+
+    if ((frames == NULL) || (frameCount <= 0)) return;
+
+    // Mixing callback runs on the calling thread, which is the only one posting commands,
+    // music is decoded between chunks so it is always ahead of mixing
+    for (int framesRendered = 0; framesRendered < frameCount; framesRendered += MUSIC_DECODER_CHUNK_FRAMES)
+    {
+        int framesToRender = frameCount - framesRendered;
+        if (framesToRender > MUSIC_DECODER_CHUNK_FRAMES) framesToRender = MUSIC_DECODER_CHUNK_FRAMES;
+
+        UpdateMusicDecoders();
+        OnSendAudioDataToDevice(&AUDIO.System.device, frames + framesRendered*AUDIO_DEVICE_CHANNELS, NULL, (ma_uint32)framesToRender);
+    }
+
+    // Master volume is applied by miniaudio after the callback on a playback device
+    float masterVolume = 1.0f;
+    ma_device_get_master_volume(&AUDIO.System.device, &masterVolume);
+
+    if (masterVolume != 1.0f)
+    {
+        for (int i = 0; i < frameCount*AUDIO_DEVICE_CHANNELS; i++) frames[i] *= masterVolume;
+    }
+}
+
+// Render audio mix into a new wave, to be exported with ExportWave() (offline audio device only)
+Wave RenderAudioWave(int frameCount)
+{
+    Wave wave = { 0 };
+
+    if (!AUDIO.System.isReady || !AUDIO.System.isOffline)
+    {
+        TRACELOG(LOG_WARNING, "AUDIO: Rendering requires an offline audio device");
+        return wave;
+    }
+
+    if (frameCount <= 0) return wave;
+
+    wave.frameCount = (unsigned int)frameCount;
+    wave.sampleRate = AUDIO.System.device.sampleRate;
+    wave.sampleSize = 32;
+    wave.channels = AUDIO_DEVICE_CHANNELS;
+    wave.data = RL_CALLOC(wave.frameCount*wave.channels, sizeof(float));
+
+    if (wave.data != NULL) RenderAudioFrames((float *)wave.data, frameCount);
+
+    return wave;
+}
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Audio Buffer management
 //----------------------------------------------------------------------------------
@@ -547,6 +859,9 @@ AudioBuffer *LoadAudioBuffer(ma_format format, ma_uint32 channels, ma_uint32 sam
     // Audio data runs through a format converter
     ma_data_converter_config converterConfig = ma_data_converter_config_init(format, AUDIO_DEVICE_FORMAT, channels, AUDIO_DEVICE_CHANNELS, sampleRate, AUDIO.System.device.sampleRate);
     converterConfig.allowDynamicSampleRate = true;
+    converterConfig.resampling.algorithm = ma_resample_algorithm_custom;
+    converterConfig.resampling.pBackendVTable = &resamplerVTable;
+    converterConfig.resampling.pBackendUserData = audioBuffer;
 
     ma_result result = ma_data_converter_init(&converterConfig, NULL, &audioBuffer->converter);
 
@@ -561,6 +876,7 @@ AudioBuffer *LoadAudioBuffer(ma_format format, ma_uint32 channels, ma_uint32 sam
     audioBuffer->volume = 1.0f;
     audioBuffer->pitch = 1.0f;
     audioBuffer->pan = 0.5f;
+    audioBuffer->resampler = AUDIO_RESAMPLER_LINEAR;
 
     audioBuffer->callback = NULL;
     audioBuffer->processor = NULL;
@@ -570,6 +886,8 @@ AudioBuffer *LoadAudioBuffer(ma_format format, ma_uint32 channels, ma_uint32 sam
     audioBuffer->looping = false;
 
     audioBuffer->usage = usage;
+    audioBuffer->poolIndex = -1;
+    audioBuffer->activeIndex = -1;
     audioBuffer->frameCursorPos = 0;
     audioBuffer->sizeInFrames = sizeInFrames;
 
@@ -589,9 +907,13 @@ void UnloadAudioBuffer(AudioBuffer *buffer)
 {
     if (buffer != NULL)
     {
-        ma_data_converter_uninit(&buffer->converter, NULL);
+        // NOTE: Untracking waits for the audio thread, buffer is not mixed anymore after it
         UntrackAudioBuffer(buffer);
-        RL_FREE(buffer->data);
+        ma_data_converter_uninit(&buffer->converter, NULL);
+
+        if (buffer->cacheEntry != NULL) ReleaseSoundCacheEntry(buffer->cacheEntry);
+        else RL_FREE(buffer->data);
+
         RL_FREE(buffer);
     }
 }
@@ -611,63 +933,37 @@ bool IsAudioBufferPlaying(AudioBuffer *buffer)
 // Use PauseAudioBuffer() and ResumeAudioBuffer() if the playback position should be maintained.
 void PlayAudioBuffer(AudioBuffer *buffer)
 {
-    if (buffer != NULL)
-    {
-        buffer->playing = true;
-        buffer->paused = false;
-        buffer->frameCursorPos = 0;
-    }
+    if (buffer != NULL) PushAudioCommand(AUDIO_COMMAND_PLAY, buffer, NULL, 0.0f, false);
 }
 
 // Stop an audio buffer
 void StopAudioBuffer(AudioBuffer *buffer)
 {
-    if (buffer != NULL)
-    {
-        if (IsAudioBufferPlaying(buffer))
-        {
-            buffer->playing = false;
-            buffer->paused = false;
-            buffer->frameCursorPos = 0;
-            buffer->framesProcessed = 0;
-            buffer->isSubBufferProcessed[0] = true;
-            buffer->isSubBufferProcessed[1] = true;
-        }
-    }
+    if (buffer != NULL) PushAudioCommand(AUDIO_COMMAND_STOP, buffer, NULL, 0.0f, false);
 }
 
 // Pause an audio buffer
 void PauseAudioBuffer(AudioBuffer *buffer)
 {
-    if (buffer != NULL) buffer->paused = true;
+    if (buffer != NULL) PushAudioCommand(AUDIO_COMMAND_PAUSE, buffer, NULL, 0.0f, false);
 }
 
 // Resume an audio buffer
 void ResumeAudioBuffer(AudioBuffer *buffer)
 {
-    if (buffer != NULL) buffer->paused = false;
+    if (buffer != NULL) PushAudioCommand(AUDIO_COMMAND_RESUME, buffer, NULL, 0.0f, false);
 }
 
 // Set volume for an audio buffer
 void SetAudioBufferVolume(AudioBuffer *buffer, float volume)
 {
-    if (buffer != NULL) buffer->volume = volume;
+    if (buffer != NULL) PushAudioCommand(AUDIO_COMMAND_VOLUME, buffer, NULL, volume, false);
 }
 
 // Set pitch for an audio buffer
 void SetAudioBufferPitch(AudioBuffer *buffer, float pitch)
 {
-    if ((buffer != NULL) && (pitch > 0.0f))
-    {
-        // Pitching is just an adjustment of the sample rate.
-        // Note that this changes the duration of the sound:
-        //  - higher pitches will make the sound faster
-        //  - lower pitches make it slower
-        ma_uint32 outputSampleRate = (ma_uint32)((float)buffer->converter.sampleRateOut/pitch);
-        ma_data_converter_set_rate(&buffer->converter, buffer->converter.sampleRateIn, outputSampleRate);
-
-        buffer->pitch = pitch;
-    }
+    if ((buffer != NULL) && (pitch > 0.0f)) PushAudioCommand(AUDIO_COMMAND_PITCH, buffer, NULL, pitch, false);
 }
 
 // Set pan for an audio buffer
@@ -676,41 +972,28 @@ void SetAudioBufferPan(AudioBuffer *buffer, float pan)
     if (pan < 0.0f) pan = 0.0f;
     else if (pan > 1.0f) pan = 1.0f;
 
-    if (buffer != NULL) buffer->pan = pan;
+    if (buffer != NULL) PushAudioCommand(AUDIO_COMMAND_PAN, buffer, NULL, pan, false);
+}
+
+// Set resampler mode for an audio buffer
+void SetAudioBufferResampler(AudioBuffer *buffer, int resampler)
+{
+    if ((resampler < AUDIO_RESAMPLER_NEAREST) || (resampler > AUDIO_RESAMPLER_SINC)) return;
+
+    if (buffer != NULL) PushAudioCommand(AUDIO_COMMAND_RESAMPLER, buffer, NULL, (float)resampler, false);
 }
 
 // Track audio buffer to linked list next position
 void TrackAudioBuffer(AudioBuffer *buffer)
 {
-    ma_mutex_lock(&AUDIO.System.lock);
-    {
-        if (AUDIO.Buffer.first == NULL) AUDIO.Buffer.first = buffer;
-        else
-        {
-            AUDIO.Buffer.last->next = buffer;
-            buffer->prev = AUDIO.Buffer.last;
-        }
-
-        AUDIO.Buffer.last = buffer;
-    }
-    ma_mutex_unlock(&AUDIO.System.lock);
+    PushAudioCommand(AUDIO_COMMAND_TRACK, buffer, NULL, 0.0f, false);
 }
 
 // Untrack audio buffer from linked list
+// NOTE: Waits for the audio thread, buffer can be freed after this call
 void UntrackAudioBuffer(AudioBuffer *buffer)
 {
-    ma_mutex_lock(&AUDIO.System.lock);
-    {
-        if (buffer->prev == NULL) AUDIO.Buffer.first = buffer->next;
-        else buffer->prev->next = buffer->next;
-
-        if (buffer->next == NULL) AUDIO.Buffer.last = buffer->prev;
-        else buffer->next->prev = buffer->prev;
-
-        buffer->prev = NULL;
-        buffer->next = NULL;
-    }
-    ma_mutex_unlock(&AUDIO.System.lock);
+    PushAudioCommand(AUDIO_COMMAND_UNTRACK, buffer, NULL, 0.0f, true);
 }
 
 //----------------------------------------------------------------------------------
@@ -827,13 +1110,21 @@ Wave LoadWaveFromMemory(const char *fileType, const unsigned char *fileData, int
 
 // Load sound from file
 // NOTE: The entire file is loaded to memory to be played (no-streaming)
+// NOTE: Sounds loaded from the same file share their decoded data, the file is only decoded and converted once
 Sound LoadSound(const char *fileName)
 {
-    Wave wave = LoadWave(fileName);
+    Sound sound = LoadSoundFromCache(fileName);
 
-    Sound sound = LoadSoundFromWave(wave);
+    if (sound.stream.buffer == NULL)
+    {
+        Wave wave = LoadWave(fileName);
+
+        sound = LoadSoundFromWave(wave);
 
-    UnloadWave(wave);       // Sound is loaded, we can unload wave
+        UnloadWave(wave);       // Sound is loaded, we can unload wave
+
+        AddSoundToCache(fileName, sound);
+    }
 
     return sound;
 }
@@ -902,6 +1193,9 @@ void UpdateSound(Sound sound, const void *data, int sampleCount)
     {
         StopAudioBuffer(sound.stream.buffer);
 
+        // Data loaded from a file can be shared with other sounds, get a copy before writing it
+        DetachSoundCacheData(sound.stream.buffer);
+
         // TODO: May want to lock/unlock this since this data buffer is read at mixing time
         memcpy(sound.stream.buffer->data, data, sampleCount*ma_get_bytes_per_frame(sound.stream.buffer->converter.formatIn, sound.stream.buffer->converter.channelsIn));
     }
@@ -1021,66 +1315,18 @@ void PlaySound(Sound sound)
 }
 
 // Play a sound in the multichannel buffer pool
+// NOTE: Pool buffer is chosen by the audio thread, it owns pool buffers state.
+// Sound volume is used as voice priority: when the pool is full (or the sound reached its
+// maximum voices) the quietest voice is replaced, or the new one is dropped if it is the quietest
 void PlaySoundMulti(Sound sound)
 {
-    int index = -1;
-    unsigned int oldAge = 0;
-    int oldIndex = -1;
-
-    // find the first non playing pool entry
-    for (int i = 0; i < MAX_AUDIO_BUFFER_POOL_CHANNELS; i++)
-    {
-        if (AUDIO.MultiChannel.channels[i] > oldAge)
-        {
-            oldAge = AUDIO.MultiChannel.channels[i];
-            oldIndex = i;
-        }
-
-        if (!IsAudioBufferPlaying(AUDIO.MultiChannel.pool[i]))
-        {
-            index = i;
-            break;
-        }
-    }
-
-    // If no none playing pool members can be index choose the oldest
-    if (index == -1)
-    {
-        TRACELOG(LOG_WARNING, "SOUND: Buffer pool is already full, count: %i", AUDIO.MultiChannel.poolCounter);
-
-        if (oldIndex == -1)
-        {
-            // Shouldn't be able to get here... but just in case something odd happens!
-            TRACELOG(LOG_WARNING, "SOUND: Buffer pool could not determine oldest buffer not playing sound");
-            return;
-        }
-
-        index = oldIndex;
-
-        // Just in case...
-        StopAudioBuffer(AUDIO.MultiChannel.pool[index]);
-    }
-
-    // Experimentally mutex lock doesn't seem to be needed this makes sense
-    // as pool[index] isn't playing and the only stuff we're copying
-    // shouldn't be changing...
-
-    AUDIO.MultiChannel.channels[index] = AUDIO.MultiChannel.poolCounter;
-    AUDIO.MultiChannel.poolCounter++;
-
-    SetAudioBufferVolume(AUDIO.MultiChannel.pool[index], sound.stream.buffer->volume);
-    SetAudioBufferPitch(AUDIO.MultiChannel.pool[index], sound.stream.buffer->pitch);
-    SetAudioBufferPan(AUDIO.MultiChannel.pool[index], sound.stream.buffer->pan);
-
-    AUDIO.MultiChannel.pool[index]->looping = sound.stream.buffer->looping;
-    AUDIO.MultiChannel.pool[index]->usage = sound.stream.buffer->usage;
-    AUDIO.MultiChannel.pool[index]->isSubBufferProcessed[0] = false;
-    AUDIO.MultiChannel.pool[index]->isSubBufferProcessed[1] = false;
-    AUDIO.MultiChannel.pool[index]->sizeInFrames = sound.stream.buffer->sizeInFrames;
-
-    AUDIO.MultiChannel.pool[index]->data = sound.stream.buffer->data;       // Fill dummy track with data for playing
+    if (sound.stream.buffer != NULL) PushAudioCommand(AUDIO_COMMAND_PLAY_MULTI, sound.stream.buffer, NULL, 0.0f, false);
+}
 
-    PlayAudioBuffer(AUDIO.MultiChannel.pool[index]);
+// Set maximum number of voices playing a sound with PlaySoundMulti() (0 = unlimited)
+void SetSoundMaxVoices(Sound sound, int maxVoices)
+{
+    if (sound.stream.buffer != NULL) PushAudioCommand(AUDIO_COMMAND_MAX_VOICES, sound.stream.buffer, NULL, (float)maxVoices, false);
 }
 
 // Stop any sound played with PlaySoundMulti()
@@ -1144,6 +1390,13 @@ void SetSoundPan(Sound sound, float pan)
     SetAudioBufferPan(sound.stream.buffer, pan);
 }
 
+// Set resampler mode for a sound, used for pitch and sample rate conversion
+// NOTE: Applies to voices played after the call with PlaySoundMulti()
+void SetSoundResampler(Sound sound, int resampler)
+{
+    SetAudioBufferResampler(sound.stream.buffer, resampler);
+}
+
 // Convert wave data to desired format
 void WaveFormat(Wave *wave, int sampleRate, int sampleSize, int channels)
 {
@@ -1606,7 +1859,31 @@ Music LoadMusicStreamFromMemory(const char *fileType, const unsigned char *data,
 // Unload music stream
 void UnloadMusicStream(Music music)
 {
-    UnloadAudioStream(music.stream);
+    MusicDecoder *decoder = (music.stream.buffer != NULL)? music.stream.buffer->decoder : NULL;
+
+    if (decoder != NULL)
+    {
+        // Remove decoder from decoder thread list
+        if (AUDIO.System.isReady) ma_mutex_lock(&AUDIO.Decoder.lock);
+
+        if (AUDIO.Decoder.first == decoder) AUDIO.Decoder.first = decoder->next;
+        else
+        {
+            MusicDecoder *prev = AUDIO.Decoder.first;
+            while ((prev != NULL) && (prev->next != decoder)) prev = prev->next;
+            if (prev != NULL) prev->next = decoder->next;
+        }
+
+        if (AUDIO.System.isReady) ma_mutex_unlock(&AUDIO.Decoder.lock);
+    }
+
+    UnloadAudioStream(music.stream);    // NOTE: Audio thread is not reading decoder anymore after this call
+
+    if (decoder != NULL)
+    {
+        ma_pcm_rb_uninit(&decoder->ring);
+        RL_FREE(decoder);
+    }
 
     if (music.ctxData != NULL)
     {
@@ -1637,13 +1914,51 @@ void PlayMusicStream(Music music)
 {
     if (music.stream.buffer != NULL)
     {
+        MusicDecoder *decoder = music.stream.buffer->decoder;
+
+        if (decoder == NULL)
+        {
+            // Music decoder is created on first play, decoding starts from current music position
+            decoder = (MusicDecoder *)RL_CALLOC(1, sizeof(MusicDecoder));
+            if (decoder == NULL) return;
+
+            ma_format format = ((music.stream.sampleSize == 8)? ma_format_u8 : ((music.stream.sampleSize == 16)? ma_format_s16 : ma_format_f32));
+
+            if (ma_pcm_rb_init(format, music.stream.channels, music.stream.sampleRate*MUSIC_DECODER_BUFFER_SECONDS, NULL, NULL, &decoder->ring) != MA_SUCCESS)
+            {
+                TRACELOG(LOG_WARNING, "STREAM: Failed to create music decoder buffer");
+                RL_FREE(decoder);
+                return;
+            }
+
+            decoder->music = music;
+            decoder->framesDecoded = (music.frameCount > 0)? music.stream.buffer->framesProcessed%music.frameCount : 0;
+            decoder->looping = music.looping;
+            decoder->refilling = 1;         // NOTE: Playback starts once the decoder thread has decoded first frames
+            music.stream.buffer->decoder = decoder;
+
+            if (AUDIO.System.isReady) ma_mutex_lock(&AUDIO.Decoder.lock);
+            decoder->next = AUDIO.Decoder.first;
+            AUDIO.Decoder.first = decoder;
+            if (AUDIO.System.isReady) ma_mutex_unlock(&AUDIO.Decoder.lock);
+
+            c89atomic_store_explicit_32(&AUDIO.Decoder.wake, 1, c89atomic_memory_order_release);
+        }
+        else
+        {
+            c89atomic_store_explicit_32(&decoder->looping, music.looping, c89atomic_memory_order_release);
+
+            // Music reached its end, decoder was rewound to start
+            if (c89atomic_load_explicit_32(&decoder->finished, c89atomic_memory_order_acquire))
+            {
+                if (AUDIO.System.isReady) ma_mutex_lock(&AUDIO.Decoder.lock);
+                ResetMusicDecoder(decoder, 0);
+                if (AUDIO.System.isReady) ma_mutex_unlock(&AUDIO.Decoder.lock);
+            }
+        }
+
         // For music streams, we need to make sure we maintain the frame cursor position
-        // This is a hack for this section of code in UpdateMusicStream()
-        // NOTE: In case window is minimized, music stream is stopped, just make sure to
-        // play again on window restore: if (IsMusicStreamPlaying(music)) PlayMusicStream(music);
-        ma_uint32 frameCursorPos = music.stream.buffer->frameCursorPos;
-        PlayAudioStream(music.stream);  // WARNING: This resets the cursor position.
-        music.stream.buffer->frameCursorPos = frameCursorPos;
+        PushAudioCommand(AUDIO_COMMAND_CONTINUE, music.stream.buffer, NULL, 0.0f, false);
     }
 }
 
@@ -1664,28 +1979,13 @@ void StopMusicStream(Music music)
 {
     StopAudioStream(music.stream);
 
-    switch (music.ctxType)
-    {
-#if defined(SUPPORT_FILEFORMAT_WAV)
-        case MUSIC_AUDIO_WAV: drwav_seek_to_first_pcm_frame((drwav *)music.ctxData); break;
-#endif
-#if defined(SUPPORT_FILEFORMAT_OGG)
-        case MUSIC_AUDIO_OGG: stb_vorbis_seek_start((stb_vorbis *)music.ctxData); break;
-#endif
-#if defined(SUPPORT_FILEFORMAT_FLAC)
-        case MUSIC_AUDIO_FLAC: drflac__seek_to_first_frame((drflac *)music.ctxData); break;
-#endif
-#if defined(SUPPORT_FILEFORMAT_MP3)
-        case MUSIC_AUDIO_MP3: drmp3_seek_to_start_of_stream((drmp3 *)music.ctxData); break;
-#endif
-#if defined(SUPPORT_FILEFORMAT_XM)
-        case MUSIC_MODULE_XM: jar_xm_reset((jar_xm_context_t *)music.ctxData); break;
-#endif
-#if defined(SUPPORT_FILEFORMAT_MOD)
-        case MUSIC_MODULE_MOD: jar_mod_seek_start((jar_mod_context_t *)music.ctxData); break;
-#endif
-        default: break;
-    }
+    // NOTE: Decoder thread can not be decoding while music is rewound
+    if (AUDIO.System.isReady) ma_mutex_lock(&AUDIO.Decoder.lock);
+
+    RewindMusicStream(music);
+    if ((music.stream.buffer != NULL) && (music.stream.buffer->decoder != NULL)) ResetMusicDecoder(music.stream.buffer->decoder, 0);
+
+    if (AUDIO.System.isReady) ma_mutex_unlock(&AUDIO.Decoder.lock);
 }
 
 // Seek music to a certain position (in seconds)
@@ -1696,6 +1996,9 @@ void SeekMusicStream(Music music, float position)
 
     unsigned int positionInFrames = (unsigned int)(position*music.stream.sampleRate);
 
+    // NOTE: Decoder thread can not be decoding while music is seeked
+    if (AUDIO.System.isReady) ma_mutex_lock(&AUDIO.Decoder.lock);
+
     switch (music.ctxType)
     {
 #if defined(SUPPORT_FILEFORMAT_WAV)
@@ -1713,150 +2016,32 @@ void SeekMusicStream(Music music, float position)
         default: break;
     }
 
-    music.stream.buffer->framesProcessed = positionInFrames;
+    // NOTE: Music position is set by the audio thread once it is playing, it is read while mixing
+    if (music.stream.buffer->decoder != NULL) ResetMusicDecoder(music.stream.buffer->decoder, positionInFrames);
+    else music.stream.buffer->framesProcessed = positionInFrames;
+
+    if (AUDIO.System.isReady) ma_mutex_unlock(&AUDIO.Decoder.lock);
 }
 
-// Update (re-fill) music buffers if data already processed
+// Update music stream settings
+// NOTE: Music is decoded ahead of playback by the decoder thread, this function only applies music.looping changes.
+// Music is decoded here only if decoder thread could not be created
 void UpdateMusicStream(Music music)
 {
-    if (music.stream.buffer == NULL) return;
+    if ((music.stream.buffer == NULL) || (music.stream.buffer->decoder == NULL)) return;
 
-    unsigned int subBufferSizeInFrames = music.stream.buffer->sizeInFrames/2;
+    c89atomic_store_explicit_32(&music.stream.buffer->decoder->looping, music.looping, c89atomic_memory_order_release);
 
-    // On first call of this function we lazily pre-allocated a temp buffer to read audio files/memory data in
-    int frameSize = music.stream.channels*music.stream.sampleSize/8;
-    unsigned int pcmSize = subBufferSizeInFrames*frameSize;
-    if (AUDIO.System.pcmBufferSize < pcmSize)
-    {
-        RL_FREE(AUDIO.System.pcmBuffer);
-        AUDIO.System.pcmBuffer = RL_CALLOC(1, pcmSize);
-        AUDIO.System.pcmBufferSize = pcmSize;
-    }
+    if (!c89atomic_load_explicit_32(&AUDIO.Decoder.isRunning, c89atomic_memory_order_acquire)) UpdateMusicDecoders();
+}
 
-    // Check both sub-buffers to check if they require refilling
-    for (int i = 0; i < 2; i++)
-    {
-        if ((music.stream.buffer != NULL) && !music.stream.buffer->isSubBufferProcessed[i]) continue; // No refilling required, move to next sub-buffer
+// Get number of times music playback ran out of decoded frames
+unsigned int GetMusicStreamUnderruns(Music music)
+{
+    if ((music.stream.buffer == NULL) || (music.stream.buffer->decoder == NULL)) return 0;
 
-        unsigned int framesLeft = music.frameCount - music.stream.buffer->framesProcessed;  // Frames left to be processed
-        unsigned int framesToStream = 0;                 // Total frames to be streamed
-        if ((framesLeft >= subBufferSizeInFrames) || music.looping) framesToStream = subBufferSizeInFrames;
-        else framesToStream = framesLeft;
-
-        int frameCountStillNeeded = framesToStream;
-        int frameCountRedTotal = 0;
-        switch (music.ctxType)
-        {
-        #if defined(SUPPORT_FILEFORMAT_WAV)
-            case MUSIC_AUDIO_WAV:
-            {
-                if (music.stream.sampleSize == 16)
-                {
-                    while (true)
-                    {
-                        int frameCountRed = drwav_read_pcm_frames_s16((drwav *)music.ctxData, frameCountStillNeeded, (short *)((char *)AUDIO.System.pcmBuffer + frameCountRedTotal*frameSize));
-                        frameCountRedTotal += frameCountRed;
-                        frameCountStillNeeded -= frameCountRed;
-                        if (frameCountStillNeeded == 0) break;
-                        else drwav_seek_to_first_pcm_frame((drwav *)music.ctxData);
-                    }
-                }
-                else if (music.stream.sampleSize == 32)
-                {
-                    while (true)
-                    {
-                        int frameCountRed = drwav_read_pcm_frames_f32((drwav *)music.ctxData, frameCountStillNeeded, (float *)((char *)AUDIO.System.pcmBuffer + frameCountRedTotal*frameSize));
-                        frameCountRedTotal += frameCountRed;
-                        frameCountStillNeeded -= frameCountRed;
-                        if (frameCountStillNeeded == 0) break;
-                        else drwav_seek_to_first_pcm_frame((drwav *)music.ctxData);
-                    }
-                }
-            } break;
-        #endif
-        #if defined(SUPPORT_FILEFORMAT_OGG)
-            case MUSIC_AUDIO_OGG:
-            {
-                while (true)
-                {
-                    int frameCountRed = stb_vorbis_get_samples_short_interleaved((stb_vorbis *)music.ctxData, music.stream.channels, (short *)((char *)AUDIO.System.pcmBuffer + frameCountRedTotal*frameSize), frameCountStillNeeded*music.stream.channels);
-                    frameCountRedTotal += frameCountRed;
-                    frameCountStillNeeded -= frameCountRed;
-                    if (frameCountStillNeeded == 0) break;
-                    else stb_vorbis_seek_start((stb_vorbis *)music.ctxData);
-                }
-            } break;
-        #endif
-        #if defined(SUPPORT_FILEFORMAT_FLAC)
-            case MUSIC_AUDIO_FLAC:
-            {
-                while (true)
-                {
-                    int frameCountRed = drflac_read_pcm_frames_s16((drflac *)music.ctxData, frameCountStillNeeded, (short *)((char *)AUDIO.System.pcmBuffer + frameCountRedTotal*frameSize));
-                    frameCountRedTotal += frameCountRed;
-                    frameCountStillNeeded -= frameCountRed;
-                    if (frameCountStillNeeded == 0) break;
-                    else drflac__seek_to_first_frame((drflac *)music.ctxData);
-                }
-            } break;
-        #endif
-        #if defined(SUPPORT_FILEFORMAT_MP3)
-            case MUSIC_AUDIO_MP3:
-            {
-                while (true)
-                {
-                    int frameCountRed = drmp3_read_pcm_frames_f32((drmp3 *)music.ctxData, frameCountStillNeeded, (float *)((char *)AUDIO.System.pcmBuffer + frameCountRedTotal*frameSize));
-                    frameCountRedTotal += frameCountRed;
-                    frameCountStillNeeded -= frameCountRed;
-                    if (frameCountStillNeeded == 0) break;
-                    else drmp3_seek_to_start_of_stream((drmp3 *)music.ctxData);
-                }
-            } break;
-        #endif
-        #if defined(SUPPORT_FILEFORMAT_XM)
-            case MUSIC_MODULE_XM:
-            {
-                // NOTE: Internally we consider 2 channels generation, so sampleCount/2
-                if (AUDIO_DEVICE_FORMAT == ma_format_f32) jar_xm_generate_samples((jar_xm_context_t *)music.ctxData, (float *)AUDIO.System.pcmBuffer, framesToStream);
-                else if (AUDIO_DEVICE_FORMAT == ma_format_s16) jar_xm_generate_samples_16bit((jar_xm_context_t *)music.ctxData, (short *)AUDIO.System.pcmBuffer, framesToStream);
-                else if (AUDIO_DEVICE_FORMAT == ma_format_u8) jar_xm_generate_samples_8bit((jar_xm_context_t *)music.ctxData, (char *)AUDIO.System.pcmBuffer, framesToStream);
-
-                //jar_xm_reset((jar_xm_context_t *)music.ctxData);
-
-            } break;
-        #endif
-        #if defined(SUPPORT_FILEFORMAT_MOD)
-            case MUSIC_MODULE_MOD:
-            {
-                // NOTE: 3rd parameter (nbsample) specify the number of stereo 16bits samples you want, so sampleCount/2
-                jar_mod_fillbuffer((jar_mod_context_t *)music.ctxData, (short *)AUDIO.System.pcmBuffer, framesToStream, 0);
-
-                //jar_mod_seek_start((jar_mod_context_t *)music.ctxData);
-
-            } break;
-        #endif
-            default: break;
-        }
-
-        UpdateAudioStream(music.stream, AUDIO.System.pcmBuffer, framesToStream);
-
-        music.stream.buffer->framesProcessed = music.stream.buffer->framesProcessed%music.frameCount;
-
-        if (framesLeft <= subBufferSizeInFrames)
-        {
-            if (!music.looping)
-            {
-                // Streaming is ending, we filled latest frames from input
-                StopMusicStream(music);
-                return;
-            }
-        }
-    }
-
-    // NOTE: In case window is minimized, music stream is stopped,
-    // just make sure to play again on window restore
-    if (IsMusicStreamPlaying(music)) PlayMusicStream(music);
-}
+    return c89atomic_load_explicit_32(&music.stream.buffer->decoder->underruns, c89atomic_memory_order_acquire);
+}
 
 // Check if any music is playing
 bool IsMusicStreamPlaying(Music music)
@@ -1908,6 +2093,12 @@ float GetMusicTimePlayed(Music music)
         }
         else
     #endif
+        if ((music.stream.buffer->decoder != NULL) && (music.frameCount > 0))
+        {
+            // Decoded music frames are counted as they are mixed
+            secondsPlayed = (float)(music.stream.buffer->framesProcessed%music.frameCount)/music.stream.sampleRate;
+        }
+        else
         {
             //ma_uint32 frameSizeInBytes = ma_get_bytes_per_sample(music.stream.buffer->dsp.formatConverterIn.config.formatIn)*music.stream.buffer->dsp.formatConverterIn.config.channels;
             int framesProcessed = (int)music.stream.buffer->framesProcessed;
@@ -2087,53 +2278,37 @@ void SetAudioStreamCallback(AudioStream stream, AudioCallback callback)
 // Add processor to audio stream. Contrary to buffers, the order of processors is important.
 // The new processor must be added at the end. As there aren't supposed to be a lot of processors attached to
 // a given stream, we iterate through the list to find the end. That way we don't need a pointer to the last element.
+// NOTE: Processors chain is only modified by the audio thread, this call waits for it
 void AttachAudioStreamProcessor(AudioStream stream, AudioCallback process)
 {
-    ma_mutex_lock(&AUDIO.System.lock);
+    if (stream.buffer == NULL) return;
 
     rAudioProcessor *processor = (rAudioProcessor *)RL_CALLOC(1, sizeof(rAudioProcessor));
     processor->process = process;
 
-    rAudioProcessor *last = stream.buffer->processor;
-
-    while (last && last->next)
-    {
-        last = last->next;
-    }
-    if (last)
-    {
-        processor->prev = last;
-        last->next = processor;
-    }
-    else stream.buffer->processor = processor;
-
-    ma_mutex_unlock(&AUDIO.System.lock);
+    PushAudioCommand(AUDIO_COMMAND_ATTACH_PROCESSOR, stream.buffer, processor, 0.0f, true);
 }
 
+// Remove processor from audio stream
+// NOTE: Chain changes are waited for, so it is safe to walk the chain from this thread
 void DetachAudioStreamProcessor(AudioStream stream, AudioCallback process)
 {
-    ma_mutex_lock(&AUDIO.System.lock);
+    if (stream.buffer == NULL) return;
 
     rAudioProcessor *processor = stream.buffer->processor;
 
     while (processor)
     {
         rAudioProcessor *next = processor->next;
-        rAudioProcessor *prev = processor->prev;
 
         if (processor->process == process)
         {
-            if (stream.buffer->processor == processor) stream.buffer->processor = next;
-            if (prev) prev->next = next;
-            if (next) next->prev = prev;
-
+            PushAudioCommand(AUDIO_COMMAND_DETACH_PROCESSOR, stream.buffer, processor, 0.0f, true);
             RL_FREE(processor);
         }
 
         processor = next;
     }
-
-    ma_mutex_unlock(&AUDIO.System.lock);
 }
 
 //----------------------------------------------------------------------------------
@@ -2146,9 +2321,936 @@ static void OnLog(void *pUserData, ma_uint32 level, const char *pMessage)
     TRACELOG(LOG_WARNING, "miniaudio: %s", pMessage);   // All log messages from miniaudio are errors
 }
 
+// Post a command to the audio thread
+// NOTE: Commands are applied directly while the device is not running, there is no audio thread to race with.
+// If wait is requested, the call returns once the audio thread has applied the command
+static void PushAudioCommand(int type, AudioBuffer *buffer, rAudioProcessor *processor, float value, bool wait)
+{
+    AudioCommand command = { type, buffer, processor, value };
+
+    if (!AUDIO.System.isReady)
+    {
+        ApplyAudioCommand(&command);
+        return;
+    }
+
+    ma_mutex_lock(&AUDIO.System.lock);
+    {
+        ma_uint32 head = AUDIO.Command.head;
+
+        // Queue full, give some time to the audio thread
+        while ((head - c89atomic_load_explicit_32(&AUDIO.Command.tail, c89atomic_memory_order_acquire)) >= AUDIO_COMMAND_QUEUE_SIZE) WaitAudioCommands();
+
+        AUDIO.Command.queue[head & (AUDIO_COMMAND_QUEUE_SIZE - 1)] = command;
+        c89atomic_store_explicit_32(&AUDIO.Command.head, head + 1, c89atomic_memory_order_release);
+
+        if (wait)
+        {
+            while (c89atomic_load_explicit_32(&AUDIO.Command.tail, c89atomic_memory_order_acquire) != (head + 1)) WaitAudioCommands();
+        }
+    }
+    ma_mutex_unlock(&AUDIO.System.lock);
+}
+
+// Wait for the audio thread to apply posted commands
+// NOTE: In case device has been stopped (i.e. lost), pending commands are applied from calling thread
+static void WaitAudioCommands(void)
+{
+    if (ma_device_is_started(&AUDIO.System.device)) ma_sleep(1);
+    else ProcessAudioCommands();
+}
+
+// Apply all posted commands, called by the audio thread before mixing
+static void ProcessAudioCommands(void)
+{
+    ma_uint32 tail = AUDIO.Command.tail;
+    ma_uint32 head = c89atomic_load_explicit_32(&AUDIO.Command.head, c89atomic_memory_order_acquire);
+
+    while (tail != head)
+    {
+        ApplyAudioCommand(&AUDIO.Command.queue[tail & (AUDIO_COMMAND_QUEUE_SIZE - 1)]);
+        tail++;
+    }
+
+    c89atomic_store_explicit_32(&AUDIO.Command.tail, tail, c89atomic_memory_order_release);
+}
+
+// Apply one audio command
+static void ApplyAudioCommand(const AudioCommand *command)
+{
+    AudioBuffer *buffer = command->buffer;
+
+    switch (command->type)
+    {
+        case AUDIO_COMMAND_PLAY:
+        {
+            if (ActivateAudioBuffer(buffer))
+            {
+                buffer->playing = true;
+                buffer->paused = false;
+                buffer->frameCursorPos = 0;
+                buffer->ending = false;
+                ma_data_converter_reset(&buffer->converter);
+            }
+        } break;
+        case AUDIO_COMMAND_CONTINUE:
+        {
+            if (ActivateAudioBuffer(buffer))
+            {
+                buffer->playing = true;
+                buffer->paused = false;
+            }
+        } break;
+        case AUDIO_COMMAND_STOP: ResetAudioBuffer(buffer); break;
+        case AUDIO_COMMAND_PAUSE: buffer->paused = true; break;
+        case AUDIO_COMMAND_RESUME: buffer->paused = false; break;
+        case AUDIO_COMMAND_VOLUME: buffer->volume = command->value; break;
+        case AUDIO_COMMAND_PITCH: UpdateAudioBufferPitch(buffer, command->value); break;
+        case AUDIO_COMMAND_PAN: buffer->pan = command->value; break;
+        case AUDIO_COMMAND_RESAMPLER: buffer->resampler = (int)command->value; break;
+        case AUDIO_COMMAND_PLAY_MULTI: PlayAudioBufferMulti(buffer); break;
+        case AUDIO_COMMAND_MAX_VOICES: buffer->maxVoices = (int)command->value; break;
+        case AUDIO_COMMAND_STOP_VOICES: StopAudioBufferVoices(buffer); break;
+        case AUDIO_COMMAND_RESET_DECODER:
+        {
+            // NOTE: Decoder position is not changed until this command is applied, the resetting thread waits for it
+            ma_pcm_rb_reset(&buffer->decoder->ring);
+            buffer->framesProcessed = buffer->decoder->framesDecoded;
+            buffer->ending = false;
+        } break;
+        case AUDIO_COMMAND_TRACK:
+        {
+            if (AUDIO.Buffer.first == NULL) AUDIO.Buffer.first = buffer;
+            else
+            {
+                AUDIO.Buffer.last->next = buffer;
+                buffer->prev = AUDIO.Buffer.last;
+            }
+
+            AUDIO.Buffer.last = buffer;
+        } break;
+        case AUDIO_COMMAND_UNTRACK:
+        {
+            StopAudioBufferVoices(buffer);     // Pool voices can not keep playing buffer data
+            DeactivateAudioBuffer(buffer);
+
+            if (buffer->prev == NULL) AUDIO.Buffer.first = buffer->next;
+            else buffer->prev->next = buffer->next;
+
+            if (buffer->next == NULL) AUDIO.Buffer.last = buffer->prev;
+            else buffer->next->prev = buffer->prev;
+
+            buffer->prev = NULL;
+            buffer->next = NULL;
+        } break;
+        case AUDIO_COMMAND_ATTACH_PROCESSOR:
+        {
+            rAudioProcessor *last = buffer->processor;
+
+            while (last && last->next) last = last->next;
+
+            if (last)
+            {
+                command->processor->prev = last;
+                last->next = command->processor;
+            }
+            else buffer->processor = command->processor;
+        } break;
+        case AUDIO_COMMAND_DETACH_PROCESSOR:
+        {
+            rAudioProcessor *next = command->processor->next;
+            rAudioProcessor *prev = command->processor->prev;
+
+            if (buffer->processor == command->processor) buffer->processor = next;
+            if (prev) prev->next = next;
+            if (next) next->prev = prev;
+        } break;
+        default: break;
+    }
+}
+
+// Stop an audio buffer and move its cursor back to the start
+// NOTE: Multichannel pool voices are released back to the free voices stack
+static void ResetAudioBuffer(AudioBuffer *buffer)
+{
+    if (IsAudioBufferPlaying(buffer))
+    {
+        buffer->playing = false;
+        buffer->paused = false;
+        buffer->frameCursorPos = 0;
+        buffer->framesProcessed = 0;
+        buffer->isSubBufferProcessed[0] = true;
+        buffer->isSubBufferProcessed[1] = true;
+        buffer->ending = false;
+
+        DeactivateAudioBuffer(buffer);
+
+        if (buffer->source != NULL)
+        {
+            buffer->source->voiceCount--;
+            buffer->source = NULL;
+
+            AUDIO.MultiChannel.freeVoices[AUDIO.MultiChannel.freeCount] = buffer->poolIndex;
+            AUDIO.MultiChannel.freeCount++;
+        }
+    }
+}
+
+// Stop multichannel pool voices playing buffer data
+static void StopAudioBufferVoices(AudioBuffer *buffer)
+{
+    for (int i = 0; (i < MAX_AUDIO_BUFFER_POOL_CHANNELS) && (buffer->voiceCount > 0); i++)
+    {
+        if ((AUDIO.MultiChannel.pool[i] != NULL) && (AUDIO.MultiChannel.pool[i]->source == buffer)) ResetAudioBuffer(AUDIO.MultiChannel.pool[i]);
+    }
+}
+
+// Update audio buffer converter rate for a new pitch
+static void UpdateAudioBufferPitch(AudioBuffer *buffer, float pitch)
+{
+    // Pitching is just an adjustment of the sample rate.
+    // Note that this changes the duration of the sound:
+    //  - higher pitches will make the sound faster
+    //  - lower pitches make it slower
+    // NOTE: Resampler only updates its step, no filter is recomputed, see OnSetResamplerRate()
+    ma_uint32 outputSampleRate = (ma_uint32)((float)buffer->converter.sampleRateOut/pitch);
+    ma_data_converter_set_rate(&buffer->converter, buffer->converter.sampleRateIn, outputSampleRate);
+
+    buffer->pitch = pitch;
+}
+
+// Compute windowed-sinc resampler weights table
+// NOTE: Blackman window, cutoff at input Nyquist frequency. Each row is normalized so DC gain is exactly 1.0
+static void InitResamplerKernel(void)
+{
+    const int halfTaps = RESAMPLER_SINC_TAPS/2;
+
+    for (int phase = 0; phase <= RESAMPLER_SINC_PHASES; phase++)
+    {
+        float *weights = AUDIO.Resampler.kernel + phase*RESAMPLER_SINC_TAPS;
+        float t = (float)phase/RESAMPLER_SINC_PHASES;
+        float sum = 0.0f;
+
+        for (int k = 0; k < RESAMPLER_SINC_TAPS; k++)
+        {
+            // Distance from output position to window frame k, output lies between frames halfTaps - 1 and halfTaps
+            float x = (float)(k - (halfTaps - 1)) - t;
+            float sinc = (x == 0.0f)? 1.0f : sinf(PI*x)/(PI*x);
+            float window = 0.42f + 0.5f*cosf(PI*x/halfTaps) + 0.08f*cosf(2.0f*PI*x/halfTaps);
+
+            weights[k] = ((x > -halfTaps) && (x < halfTaps))? sinc*window : 0.0f;
+            sum += weights[k];
+        }
+
+        for (int k = 0; k < RESAMPLER_SINC_TAPS; k++) weights[k] /= sum;
+    }
+}
+
+// Add input frame to resampler window, oldest frame is dropped
+static void PushResamplerFrame(ResamplerState *state, const float *frame)
+{
+    float *first = state->frames + state->head*state->channels;
+    float *mirror = first + RESAMPLER_SINC_TAPS*state->channels;
+
+    for (ma_uint32 c = 0; c < state->channels; c++)
+    {
+        first[c] = frame[c];
+        mirror[c] = frame[c];
+    }
+
+    state->head = (state->head + 1)%RESAMPLER_SINC_TAPS;
+}
+
+// Interpolate output frame from resampler window, at state position
+static void ResampleFrame(ResamplerState *state, int mode, float *frameOut)
+{
+    const ma_uint32 channels = state->channels;
+    const float *window = state->frames + state->head*channels;
+    const float *prev = window + (RESAMPLER_SINC_TAPS - 1 - GetResamplerLatency(mode))*channels;
+    const float *next = prev + channels;
+    const float t = state->position;
+
+    switch (mode)
+    {
+        case AUDIO_RESAMPLER_NEAREST:
+        {
+            const float *nearest = (t < 0.5f)? prev : next;
+            for (ma_uint32 c = 0; c < channels; c++) frameOut[c] = nearest[c];
+        } break;
+        case AUDIO_RESAMPLER_LINEAR:
+        {
+        #if defined(AUDIO_MIX_AVX) || defined(AUDIO_MIX_SSE)
+            if (channels == 2)
+            {
+                // Both stereo frames in one register, weighted and folded: prev*(1 - t) + next*t
+                __m128 frames = _mm_mul_ps(_mm_loadu_ps(prev), _mm_setr_ps(1.0f - t, 1.0f - t, t, t));
+                _mm_storel_pi((__m64 *)frameOut, _mm_add_ps(frames, _mm_movehl_ps(frames, frames)));
+                break;
+            }
+        #endif
+            for (ma_uint32 c = 0; c < channels; c++) frameOut[c] = prev[c] + (next[c] - prev[c])*t;
+        } break;
+        case AUDIO_RESAMPLER_SINC:
+        {
+            const float *weights = AUDIO.Resampler.kernel + (int)(t*RESAMPLER_SINC_PHASES + 0.5f)*RESAMPLER_SINC_TAPS;
+
+        #if defined(AUDIO_MIX_AVX) || defined(AUDIO_MIX_SSE)
+            if (channels == 1)
+            {
+                __m128 sum = _mm_setzero_ps();
+                for (int k = 0; k < RESAMPLER_SINC_TAPS; k += 4) sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(window + k), _mm_loadu_ps(weights + k)));
+
+                sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+                frameOut[0] = _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+                break;
+            }
+            else if (channels == 2)
+            {
+                // Weights are duplicated for left and right samples, two frames per register
+                __m128 sum = _mm_setzero_ps();
+                for (int k = 0; k < RESAMPLER_SINC_TAPS; k += 4)
+                {
+                    __m128 w = _mm_loadu_ps(weights + k);
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(window + k*2), _mm_unpacklo_ps(w, w)));
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(window + k*2 + 4), _mm_unpackhi_ps(w, w)));
+                }
+
+                _mm_storel_pi((__m64 *)frameOut, _mm_add_ps(sum, _mm_movehl_ps(sum, sum)));
+                break;
+            }
+        #endif
+            for (ma_uint32 c = 0; c < channels; c++)
+            {
+                float sum = 0.0f;
+                for (int k = 0; k < RESAMPLER_SINC_TAPS; k++) sum += window[k*channels + c]*weights[k];
+                frameOut[c] = sum;
+            }
+        } break;
+        default: break;
+    }
+}
+
+// Get resampler mode latency, input frames pushed before the first one is interpolated
+// NOTE: Nearest and linear only need the two newest frames, sinc needs half of its window ahead
+static int GetResamplerLatency(int mode)
+{
+    return (mode == AUDIO_RESAMPLER_SINC)? RESAMPLER_SINC_TAPS/2 : 1;
+}
+
+// Resampler backend: state is allocated by miniaudio as part of the converter
+static ma_result OnGetResamplerHeapSize(void *pUserData, const ma_resampler_config *pConfig, size_t *pHeapSizeInBytes)
+{
+    (void)pUserData;
+
+    if ((pConfig->format != ma_format_f32) || (pConfig->channels > AUDIO_DEVICE_CHANNELS)) return MA_INVALID_ARGS;
+
+    *pHeapSizeInBytes = sizeof(ResamplerState);
+
+    return MA_SUCCESS;
+}
+
+// Resampler backend: init state
+static ma_result OnInitResampler(void *pUserData, const ma_resampler_config *pConfig, void *pHeap, ma_resampling_backend **ppBackend)
+{
+    ResamplerState *state = (ResamplerState *)pHeap;
+
+    memset(state, 0, sizeof(ResamplerState));
+    state->channels = pConfig->channels;
+    state->position = 1.0f;         // NOTE: First input frame is pushed before first output frame
+    *ppBackend = state;
+
+    return OnSetResamplerRate(pUserData, state, pConfig->sampleRateIn, pConfig->sampleRateOut);
+}
+
+// Resampler backend: uninit state
+// NOTE: Nothing to release, state memory is owned by miniaudio
+static void OnUninitResampler(void *pUserData, ma_resampling_backend *pBackend, const ma_allocation_callbacks *pAllocationCallbacks)
+{
+    (void)pUserData;
+    (void)pBackend;
+    (void)pAllocationCallbacks;
+}
+
+// Resampler backend: resample input frames, at buffer resampler mode
+static ma_result OnProcessResampler(void *pUserData, ma_resampling_backend *pBackend, const void *pFramesIn, ma_uint64 *pFrameCountIn, void *pFramesOut, ma_uint64 *pFrameCountOut)
+{
+    ResamplerState *state = (ResamplerState *)pBackend;
+    const int mode = ((AudioBuffer *)pUserData)->resampler;
+    const float silence[AUDIO_DEVICE_CHANNELS] = { 0 };
+
+    ma_uint64 framesIn = 0;
+    ma_uint64 framesOut = 0;
+
+    while (framesOut < *pFrameCountOut)
+    {
+        // Move window up to output position, stop when input frames run out
+        while ((state->position >= 1.0f) && (framesIn < *pFrameCountIn))
+        {
+            PushResamplerFrame(state, (pFramesIn != NULL)? (const float *)pFramesIn + framesIn*state->channels : silence);
+            state->position -= 1.0f;
+            framesIn++;
+        }
+
+        if (state->position >= 1.0f) break;
+
+        ResampleFrame(state, mode, (float *)pFramesOut + framesOut*state->channels);
+        state->position += state->step;
+        framesOut++;
+    }
+
+    *pFrameCountIn = framesIn;
+    *pFrameCountOut = framesOut;
+
+    return MA_SUCCESS;
+}
+
+// Resampler backend: sample rate change, called on every pitch change
+static ma_result OnSetResamplerRate(void *pUserData, ma_resampling_backend *pBackend, ma_uint32 sampleRateIn, ma_uint32 sampleRateOut)
+{
+    (void)pUserData;
+
+    ((ResamplerState *)pBackend)->step = (float)sampleRateIn/(float)sampleRateOut;
+
+    return MA_SUCCESS;
+}
+
+// Resampler backend: latency, input frames pushed before the first one is interpolated
+static ma_uint64 OnGetResamplerInputLatency(void *pUserData, const ma_resampling_backend *pBackend)
+{
+    (void)pBackend;
+
+    return GetResamplerLatency(((AudioBuffer *)pUserData)->resampler);
+}
+
+// Resampler backend: latency, in output frames
+static ma_uint64 OnGetResamplerOutputLatency(void *pUserData, const ma_resampling_backend *pBackend)
+{
+    return (ma_uint64)(GetResamplerLatency(((AudioBuffer *)pUserData)->resampler)/((const ResamplerState *)pBackend)->step);
+}
+
+// Resampler backend: input frames pushed to produce outputFrameCount frames
+static ma_result OnGetResamplerRequiredInputFrameCount(void *pUserData, const ma_resampling_backend *pBackend, ma_uint64 outputFrameCount, ma_uint64 *pInputFrameCount)
+{
+    (void)pUserData;
+    const ResamplerState *state = (const ResamplerState *)pBackend;
+
+    // NOTE: Window moves before each output frame, last one is at position + (outputFrameCount - 1)*step
+    *pInputFrameCount = (outputFrameCount == 0)? 0 : (ma_uint64)(state->position + (double)(outputFrameCount - 1)*state->step);
+
+    return MA_SUCCESS;
+}
+
+// Resampler backend: output frames produced from inputFrameCount frames
+static ma_result OnGetResamplerExpectedOutputFrameCount(void *pUserData, const ma_resampling_backend *pBackend, ma_uint64 inputFrameCount, ma_uint64 *pOutputFrameCount)
+{
+    (void)pUserData;
+    const ResamplerState *state = (const ResamplerState *)pBackend;
+
+    // NOTE: Output frames are produced while their position is within the input frames
+    double range = (double)inputFrameCount + 1.0 - state->position;
+    *pOutputFrameCount = (range > 0.0)? (ma_uint64)ceil(range/state->step) : 0;
+
+    return MA_SUCCESS;
+}
+
+// Resampler backend: clear window, buffer plays from the start
+static ma_result OnResetResampler(void *pUserData, ma_resampling_backend *pBackend)
+{
+    (void)pUserData;
+    ResamplerState *state = (ResamplerState *)pBackend;
+
+    memset(state->frames, 0, sizeof(state->frames));
+    state->position = 1.0f;
+    state->head = 0;
+
+    return MA_SUCCESS;
+}
+
+// Play source buffer data on a free multichannel pool voice
+// NOTE: Voices are taken from the free voices stack, lowest priority voice is only searched for when stealing
+static void PlayAudioBufferMulti(AudioBuffer *source)
+{
+    float priority = source->volume;
+    int stealIndex = -1;
+
+    if ((source->maxVoices > 0) && (source->voiceCount >= source->maxVoices))
+    {
+        // Sound reached its voices limit, replace its lowest priority voice
+        stealIndex = GetVoiceToSteal(source, priority);
+        if (stealIndex == -1) return;
+    }
+    else if (AUDIO.MultiChannel.freeCount == 0)
+    {
+        // Pool is full, replace the lowest priority voice
+        stealIndex = GetVoiceToSteal(NULL, priority);
+        if (stealIndex == -1) return;
+    }
+
+    if (stealIndex != -1) ResetAudioBuffer(AUDIO.MultiChannel.pool[stealIndex]);
+    if (AUDIO.MultiChannel.freeCount == 0) return;      // Shouldn't be able to get here... but just in case
+
+    int index = AUDIO.MultiChannel.freeVoices[AUDIO.MultiChannel.freeCount - 1];
+    AudioBuffer *buffer = AUDIO.MultiChannel.pool[index];
+
+    if (!ActivateAudioBuffer(buffer)) return;
+    AUDIO.MultiChannel.freeCount--;
+
+    AUDIO.MultiChannel.channels[index] = AUDIO.MultiChannel.poolCounter;
+    AUDIO.MultiChannel.priority[index] = priority;
+    AUDIO.MultiChannel.poolCounter++;
+
+    buffer->source = source;
+    source->voiceCount++;
+
+    buffer->volume = source->volume;
+    buffer->pan = source->pan;
+    buffer->resampler = source->resampler;
+    if (buffer->pitch != source->pitch) UpdateAudioBufferPitch(buffer, source->pitch);
+    ma_data_converter_reset(&buffer->converter);    // NOTE: Previous data must not be interpolated into new one
+
+    buffer->looping = source->looping;
+    buffer->usage = source->usage;
+    buffer->isSubBufferProcessed[0] = false;
+    buffer->isSubBufferProcessed[1] = false;
+    buffer->sizeInFrames = source->sizeInFrames;
+
+    buffer->data = source->data;        // Fill dummy track with data for playing
+
+    buffer->playing = true;
+    buffer->paused = false;
+    buffer->frameCursorPos = 0;
+}
+
+// Load sound sharing cached data from a previous LoadSound() call
+// NOTE: Every sound gets its own audio buffer (playing state, volume, pitch...), only data is shared
+static Sound LoadSoundFromCache(const char *fileName)
+{
+    Sound sound = { 0 };
+
+    for (SoundCacheEntry *entry = AUDIO.SoundCache.first; entry != NULL; entry = entry->next)
+    {
+        if ((entry->sampleRate != AUDIO.System.device.sampleRate) || (strcmp(entry->fileName, fileName) != 0)) continue;
+
+        AudioBuffer *audioBuffer = LoadAudioBuffer(AUDIO_DEVICE_FORMAT, AUDIO_DEVICE_CHANNELS, AUDIO.System.device.sampleRate, 0, AUDIO_BUFFER_USAGE_STATIC);
+        if (audioBuffer == NULL) break;
+
+        audioBuffer->data = entry->data;
+        audioBuffer->sizeInFrames = entry->frameCount;
+        audioBuffer->cacheEntry = entry;
+        entry->refCount++;
+
+        sound.frameCount = entry->frameCount;
+        sound.stream.sampleRate = AUDIO.System.device.sampleRate;
+        sound.stream.sampleSize = 32;
+        sound.stream.channels = AUDIO_DEVICE_CHANNELS;
+        sound.stream.buffer = audioBuffer;
+        break;
+    }
+
+    return sound;
+}
+
+// Add sound data to cache, the cache entry takes ownership of it
+static void AddSoundToCache(const char *fileName, Sound sound)
+{
+    if ((sound.stream.buffer == NULL) || (sound.stream.buffer->data == NULL)) return;
+
+    SoundCacheEntry *entry = (SoundCacheEntry *)RL_CALLOC(1, sizeof(SoundCacheEntry));
+    if (entry == NULL) return;
+
+    entry->fileName = (char *)RL_MALLOC(strlen(fileName) + 1);
+    if (entry->fileName == NULL)
+    {
+        RL_FREE(entry);
+        return;
+    }
+
+    strcpy(entry->fileName, fileName);
+    entry->sampleRate = sound.stream.sampleRate;
+    entry->data = sound.stream.buffer->data;
+    entry->frameCount = sound.stream.buffer->sizeInFrames;
+    entry->refCount = 1;
+
+    entry->next = AUDIO.SoundCache.first;
+    AUDIO.SoundCache.first = entry;
+
+    sound.stream.buffer->cacheEntry = entry;
+}
+
+// Release one reference to cached sound data, data is unloaded with the last one
+static void ReleaseSoundCacheEntry(SoundCacheEntry *entry)
+{
+    entry->refCount--;
+    if (entry->refCount > 0) return;
+
+    // Remove entry from cache list
+    if (AUDIO.SoundCache.first == entry) AUDIO.SoundCache.first = entry->next;
+    else
+    {
+        SoundCacheEntry *prev = AUDIO.SoundCache.first;
+        while ((prev != NULL) && (prev->next != entry)) prev = prev->next;
+        if (prev != NULL) prev->next = entry->next;
+    }
+
+    RL_FREE(entry->data);
+    RL_FREE(entry->fileName);
+    RL_FREE(entry);
+}
+
+// Make buffer own its data, so it can be modified without changing other sounds
+// NOTE: Last sound sharing the data just takes it, cache entry is removed
+static void DetachSoundCacheData(AudioBuffer *buffer)
+{
+    SoundCacheEntry *entry = buffer->cacheEntry;
+    if (entry == NULL) return;
+
+    if (entry->refCount > 1)
+    {
+        // Pool voices started by this sound play the shared data, which may be unloaded by other sounds
+        PushAudioCommand(AUDIO_COMMAND_STOP_VOICES, buffer, NULL, 0.0f, true);
+
+        unsigned int dataSize = entry->frameCount*AUDIO_DEVICE_CHANNELS*ma_get_bytes_per_sample(AUDIO_DEVICE_FORMAT);
+        unsigned char *data = (unsigned char *)RL_MALLOC(dataSize);
+        if (data == NULL) return;
+
+        memcpy(data, entry->data, dataSize);
+        buffer->data = data;
+    }
+    else entry->data = NULL;    // Data is kept by buffer, not unloaded with the entry
+
+    buffer->cacheEntry = NULL;
+    ReleaseSoundCacheEntry(entry);
+}
+
+// Music decoder thread
+// NOTE: Wakes up periodically to keep every music ring buffer filled, it never waits on the audio thread
+static ma_thread_result MA_THREADCALL MusicDecoderThread(void *pData)
+{
+    (void)pData;
+
+    while (c89atomic_load_explicit_32(&AUDIO.Decoder.isRunning, c89atomic_memory_order_acquire))
+    {
+        UpdateMusicDecoders();
+
+        // NOTE: Waiting is cut short when a music stream starts playing or is reset, so its first frames are decoded right away
+        for (int i = 0; (i < 10) && !c89atomic_exchange_explicit_32(&AUDIO.Decoder.wake, 0, c89atomic_memory_order_acq_rel); i++) ma_sleep(1);
+    }
+
+    return (ma_thread_result)0;
+}
+
+// Decode music ahead of playback for all music streams
+static void UpdateMusicDecoders(void)
+{
+    if (AUDIO.System.isReady) ma_mutex_lock(&AUDIO.Decoder.lock);
+
+    for (MusicDecoder *decoder = AUDIO.Decoder.first; decoder != NULL; decoder = decoder->next) FillMusicDecoder(decoder);
+
+    if (AUDIO.System.isReady) ma_mutex_unlock(&AUDIO.Decoder.lock);
+}
+
+// Decode music until decoder ring buffer is full or music end is reached
+static void FillMusicDecoder(MusicDecoder *decoder)
+{
+    Music *music = &decoder->music;
+
+    while (!c89atomic_load_explicit_32(&decoder->finished, c89atomic_memory_order_acquire))
+    {
+        bool looping = (c89atomic_load_explicit_32(&decoder->looping, c89atomic_memory_order_acquire) != 0);
+
+        ma_uint32 frameCount = ma_pcm_rb_available_write(&decoder->ring);
+        if (frameCount < MUSIC_DECODER_CHUNK_FRAMES) break;
+
+        frameCount = MUSIC_DECODER_CHUNK_FRAMES;
+        if (!looping && (frameCount > (music->frameCount - decoder->framesDecoded))) frameCount = music->frameCount - decoder->framesDecoded;
+
+        // NOTE: Less frames could be available at the end of the ring buffer, next iteration continues from the start
+        void *frames = NULL;
+        ma_pcm_rb_acquire_write(&decoder->ring, &frameCount, &frames);
+        ReadMusicStreamFrames(*music, frames, frameCount);
+        ma_pcm_rb_commit_write(&decoder->ring, frameCount);
+
+        decoder->framesDecoded += frameCount;
+
+        if (decoder->framesDecoded >= music->frameCount)
+        {
+            if (looping) decoder->framesDecoded %= music->frameCount;
+            else
+            {
+                // Music ending, audio thread stops it once decoded frames are played
+                RewindMusicStream(*music);
+                decoder->framesDecoded = 0;
+                c89atomic_store_explicit_32(&decoder->finished, 1, c89atomic_memory_order_release);
+            }
+        }
+    }
+
+    c89atomic_store_explicit_32(&decoder->refilling, 0, c89atomic_memory_order_release);
+}
+
+// Discard decoded frames, decoding continues from position
+// NOTE: Requires decoders lock. Ring buffer is reset by its reader, the audio thread, while decoder thread is locked out,
+// audio thread also moves music position there, decoder thread is woken up to refill the ring buffer
+static void ResetMusicDecoder(MusicDecoder *decoder, unsigned int position)
+{
+    // NOTE: Music end flag is cleared first, audio thread must not stop playing on the emptied ring buffer
+    c89atomic_store_explicit_32(&decoder->refilling, 1, c89atomic_memory_order_release);
+    c89atomic_store_explicit_32(&decoder->finished, 0, c89atomic_memory_order_release);
+
+    decoder->framesDecoded = position;
+    PushAudioCommand(AUDIO_COMMAND_RESET_DECODER, decoder->music.stream.buffer, NULL, 0.0f, true);
+
+    c89atomic_store_explicit_32(&AUDIO.Decoder.wake, 1, c89atomic_memory_order_release);
+}
+
+// Read music frames from decoding context
+// NOTE: Decoding wraps to music start at the end, caller limits frameCount for non looping music
+static void ReadMusicStreamFrames(Music music, void *frames, unsigned int frameCount)
+{
+    int frameSize = music.stream.channels*music.stream.sampleSize/8;
+    int frameCountStillNeeded = frameCount;
+    int frameCountRedTotal = 0;
+
+    switch (music.ctxType)
+    {
+    #if defined(SUPPORT_FILEFORMAT_WAV)
+        case MUSIC_AUDIO_WAV:
+        {
+            if (music.stream.sampleSize == 16)
+            {
+                while (true)
+                {
+                    int frameCountRed = drwav_read_pcm_frames_s16((drwav *)music.ctxData, frameCountStillNeeded, (short *)((char *)frames + frameCountRedTotal*frameSize));
+                    frameCountRedTotal += frameCountRed;
+                    frameCountStillNeeded -= frameCountRed;
+                    if (frameCountStillNeeded == 0) break;
+                    else drwav_seek_to_first_pcm_frame((drwav *)music.ctxData);
+                }
+            }
+            else if (music.stream.sampleSize == 32)
+            {
+                while (true)
+                {
+                    int frameCountRed = drwav_read_pcm_frames_f32((drwav *)music.ctxData, frameCountStillNeeded, (float *)((char *)frames + frameCountRedTotal*frameSize));
+                    frameCountRedTotal += frameCountRed;
+                    frameCountStillNeeded -= frameCountRed;
+                    if (frameCountStillNeeded == 0) break;
+                    else drwav_seek_to_first_pcm_frame((drwav *)music.ctxData);
+                }
+            }
+        } break;
+    #endif
+    #if defined(SUPPORT_FILEFORMAT_OGG)
+        case MUSIC_AUDIO_OGG:
+        {
+            while (true)
+            {
+                int frameCountRed = stb_vorbis_get_samples_short_interleaved((stb_vorbis *)music.ctxData, music.stream.channels, (short *)((char *)frames + frameCountRedTotal*frameSize), frameCountStillNeeded*music.stream.channels);
+                frameCountRedTotal += frameCountRed;
+                frameCountStillNeeded -= frameCountRed;
+                if (frameCountStillNeeded == 0) break;
+                else stb_vorbis_seek_start((stb_vorbis *)music.ctxData);
+            }
+        } break;
+    #endif
+    #if defined(SUPPORT_FILEFORMAT_FLAC)
+        case MUSIC_AUDIO_FLAC:
+        {
+            while (true)
+            {
+                int frameCountRed = drflac_read_pcm_frames_s16((drflac *)music.ctxData, frameCountStillNeeded, (short *)((char *)frames + frameCountRedTotal*frameSize));
+                frameCountRedTotal += frameCountRed;
+                frameCountStillNeeded -= frameCountRed;
+                if (frameCountStillNeeded == 0) break;
+                else drflac__seek_to_first_frame((drflac *)music.ctxData);
+            }
+        } break;
+    #endif
+    #if defined(SUPPORT_FILEFORMAT_MP3)
+        case MUSIC_AUDIO_MP3:
+        {
+            while (true)
+            {
+                int frameCountRed = drmp3_read_pcm_frames_f32((drmp3 *)music.ctxData, frameCountStillNeeded, (float *)((char *)frames + frameCountRedTotal*frameSize));
+                frameCountRedTotal += frameCountRed;
+                frameCountStillNeeded -= frameCountRed;
+                if (frameCountStillNeeded == 0) break;
+                else drmp3_seek_to_start_of_stream((drmp3 *)music.ctxData);
+            }
+        } break;
+    #endif
+    #if defined(SUPPORT_FILEFORMAT_XM)
+        case MUSIC_MODULE_XM:
+        {
+            // NOTE: Internally we consider 2 channels generation, so sampleCount/2
+            if (AUDIO_DEVICE_FORMAT == ma_format_f32) jar_xm_generate_samples((jar_xm_context_t *)music.ctxData, (float *)frames, frameCount);
+            else if (AUDIO_DEVICE_FORMAT == ma_format_s16) jar_xm_generate_samples_16bit((jar_xm_context_t *)music.ctxData, (short *)frames, frameCount);
+            else if (AUDIO_DEVICE_FORMAT == ma_format_u8) jar_xm_generate_samples_8bit((jar_xm_context_t *)music.ctxData, (char *)frames, frameCount);
+
+            //jar_xm_reset((jar_xm_context_t *)music.ctxData);
+
+        } break;
+    #endif
+    #if defined(SUPPORT_FILEFORMAT_MOD)
+        case MUSIC_MODULE_MOD:
+        {
+            // NOTE: 3rd parameter (nbsample) specify the number of stereo 16bits samples you want, so sampleCount/2
+            jar_mod_fillbuffer((jar_mod_context_t *)music.ctxData, (short *)frames, frameCount, 0);
+
+            //jar_mod_seek_start((jar_mod_context_t *)music.ctxData);
+
+        } break;
+    #endif
+        default: break;
+    }
+}
+
+// Seek music decoding context to start
+static void RewindMusicStream(Music music)
+{
+    switch (music.ctxType)
+    {
+#if defined(SUPPORT_FILEFORMAT_WAV)
+        case MUSIC_AUDIO_WAV: drwav_seek_to_first_pcm_frame((drwav *)music.ctxData); break;
+#endif
+#if defined(SUPPORT_FILEFORMAT_OGG)
+        case MUSIC_AUDIO_OGG: stb_vorbis_seek_start((stb_vorbis *)music.ctxData); break;
+#endif
+#if defined(SUPPORT_FILEFORMAT_FLAC)
+        case MUSIC_AUDIO_FLAC: drflac__seek_to_first_frame((drflac *)music.ctxData); break;
+#endif
+#if defined(SUPPORT_FILEFORMAT_MP3)
+        case MUSIC_AUDIO_MP3: drmp3_seek_to_start_of_stream((drmp3 *)music.ctxData); break;
+#endif
+#if defined(SUPPORT_FILEFORMAT_XM)
+        case MUSIC_MODULE_XM: jar_xm_reset((jar_xm_context_t *)music.ctxData); break;
+#endif
+#if defined(SUPPORT_FILEFORMAT_MOD)
+        case MUSIC_MODULE_MOD: jar_mod_seek_start((jar_mod_context_t *)music.ctxData); break;
+#endif
+        default: break;
+    }
+}
+
+// Read decoded music frames from decoder ring buffer
+// NOTE: Missing frames are filled with silence, counted as underrun unless music is ending
+static ma_uint32 ReadMusicDecoderFrames(AudioBuffer *audioBuffer, void *framesOut, ma_uint32 frameCount)
+{
+    MusicDecoder *decoder = audioBuffer->decoder;
+    ma_uint32 frameSizeInBytes = ma_get_bytes_per_frame(audioBuffer->converter.formatIn, audioBuffer->converter.channelsIn);
+    ma_uint32 framesRead = 0;
+
+    while (framesRead < frameCount)
+    {
+        ma_uint32 framesToRead = frameCount - framesRead;
+        void *frames = NULL;
+
+        ma_pcm_rb_acquire_read(&decoder->ring, &framesToRead, &frames);
+        if (framesToRead == 0) break;
+
+        memcpy((unsigned char *)framesOut + framesRead*frameSizeInBytes, frames, framesToRead*frameSizeInBytes);
+        ma_pcm_rb_commit_read(&decoder->ring, framesToRead);
+        framesRead += framesToRead;
+    }
+
+    audioBuffer->framesProcessed += framesRead;
+
+    if (framesRead < frameCount)
+    {
+        memset((unsigned char *)framesOut + framesRead*frameSizeInBytes, 0, (frameCount - framesRead)*frameSizeInBytes);
+
+        if (c89atomic_load_explicit_32(&decoder->finished, c89atomic_memory_order_acquire))
+        {
+            if (!audioBuffer->ending)
+            {
+                audioBuffer->ending = true;
+                audioBuffer->tailFrames = (ma_uint32)ma_data_converter_get_input_latency(&audioBuffer->converter);
+            }
+
+            ReadAudioBufferTail(audioBuffer, frameCount - framesRead);
+        }
+        else if (!c89atomic_load_explicit_32(&decoder->refilling, c89atomic_memory_order_acquire)) c89atomic_fetch_add_explicit_32(&decoder->underruns, 1, c89atomic_memory_order_relaxed);
+    }
+
+    // NOTE: Stream buffers always report all frames read, silence included
+    return frameCount;
+}
+
+// Read silence frames flushing resampler window after buffer data ended
+// NOTE: Returns frames read, buffer is stopped once all tail frames are read
+static ma_uint32 ReadAudioBufferTail(AudioBuffer *buffer, ma_uint32 frameCount)
+{
+    ma_uint32 framesRead = (frameCount < buffer->tailFrames)? frameCount : buffer->tailFrames;
+    buffer->tailFrames -= framesRead;
+
+    if (buffer->tailFrames == 0) ResetAudioBuffer(buffer);
+
+    return framesRead;
+}
+
+// Add buffer to active buffers array
+// NOTE: Returns false if array is full, buffer can not be played
+static bool ActivateAudioBuffer(AudioBuffer *buffer)
+{
+    if (buffer->activeIndex != -1) return true;
+    if (AUDIO.Buffer.activeCount >= MAX_AUDIO_ACTIVE_BUFFERS) return false;
+
+    buffer->activeIndex = AUDIO.Buffer.activeCount;
+    AUDIO.Buffer.active[AUDIO.Buffer.activeCount] = buffer;
+    AUDIO.Buffer.activeCount++;
+    buffer->mixGainSet = false;     // NOTE: Gains are not ramped when starting to play
+
+    return true;
+}
+
+// Remove buffer from active buffers array, last active buffer is moved to its place
+static void DeactivateAudioBuffer(AudioBuffer *buffer)
+{
+    if (buffer->activeIndex == -1) return;
+
+    AudioBuffer *last = AUDIO.Buffer.active[AUDIO.Buffer.activeCount - 1];
+    last->activeIndex = buffer->activeIndex;
+    AUDIO.Buffer.active[buffer->activeIndex] = last;
+    AUDIO.Buffer.activeCount--;
+
+    buffer->activeIndex = -1;
+}
+
+// Get the lowest priority playing pool voice (oldest one on equal priority), optionally only voices playing source
+// NOTE: Returns -1 if every candidate voice has a higher priority than the requested one
+static int GetVoiceToSteal(AudioBuffer *source, float priority)
+{
+    int index = -1;
+
+    for (int i = 0; i < MAX_AUDIO_BUFFER_POOL_CHANNELS; i++)
+    {
+        AudioBuffer *voice = AUDIO.MultiChannel.pool[i];
+
+        if ((voice == NULL) || (voice->source == NULL)) continue;
+        if ((source != NULL) && (voice->source != source)) continue;
+
+        if ((index == -1) || (AUDIO.MultiChannel.priority[i] < AUDIO.MultiChannel.priority[index]) ||
+            ((AUDIO.MultiChannel.priority[i] == AUDIO.MultiChannel.priority[index]) && (AUDIO.MultiChannel.channels[i] < AUDIO.MultiChannel.channels[index]))) index = i;
+    }
+
+    if ((index != -1) && (AUDIO.MultiChannel.priority[index] > priority)) index = -1;
+
+    return index;
+}
+
 // Reads audio data from an AudioBuffer object in internal format.
 static ma_uint32 ReadAudioBufferFramesInInternalFormat(AudioBuffer *audioBuffer, void *framesOut, ma_uint32 frameCount)
 {
+    // Using music decoder ring buffer
+    if (audioBuffer->decoder != NULL) return ReadMusicDecoderFrames(audioBuffer, framesOut, frameCount);
+
+    // Sound data ended, only silence left to flush resampler
+    if (audioBuffer->ending)
+    {
+        ma_silence_pcm_frames(framesOut, frameCount, audioBuffer->converter.formatIn, audioBuffer->converter.channelsIn);
+        return ReadAudioBufferTail(audioBuffer, frameCount);
+    }
+
     // Using audio buffer callback
     if (audioBuffer->callback)
     {
@@ -2217,10 +3319,12 @@ static ma_uint32 ReadAudioBufferFramesInInternalFormat(AudioBuffer *audioBuffer,
 
             currentSubBufferIndex = (currentSubBufferIndex + 1)%2;
 
-            // We need to break from this loop if we're not looping
+            // We need to break from this loop if we're not looping,
+            // buffer stops once resampler last frames are flushed with silence
             if (!audioBuffer->looping)
             {
-                StopAudioBuffer(audioBuffer);
+                audioBuffer->ending = true;
+                audioBuffer->tailFrames = (ma_uint32)ma_data_converter_get_input_latency(&audioBuffer->converter);
                 break;
             }
         }
@@ -2230,13 +3334,16 @@ static ma_uint32 ReadAudioBufferFramesInInternalFormat(AudioBuffer *audioBuffer,
     ma_uint32 totalFramesRemaining = (frameCount - framesRead);
     if (totalFramesRemaining > 0)
     {
-        memset((unsigned char *)framesOut + (framesRead*frameSizeInBytes), 0, totalFramesRemaining*frameSizeInBytes);
+        ma_silence_pcm_frames((unsigned char *)framesOut + (framesRead*frameSizeInBytes), totalFramesRemaining, audioBuffer->converter.formatIn, audioBuffer->converter.channelsIn);
 
         // For static buffers we can fill the remaining frames with silence for safety, but we don't want
         // to report those frames as "read". The reason for this is that the caller uses the return value
         // to know whether or not a non-looping sound has finished playback.
+        // Only the silence flushing resampler last frames is read, once sound data ended
         if (audioBuffer->usage != AUDIO_BUFFER_USAGE_STATIC) framesRead += totalFramesRemaining;
+        else if (audioBuffer->ending) framesRead += ReadAudioBufferTail(audioBuffer, totalFramesRemaining);
     }
+    else if (audioBuffer->ending) ReadAudioBufferTail(audioBuffer, 0);   // NOTE: Buffer stops here if resampler has no latency
 
     return framesRead;
 }
@@ -2298,94 +3405,97 @@ static void OnSendAudioDataToDevice(ma_device *pDevice, void *pFramesOut, const
     // Mixing is basically just an accumulation, we need to initialize the output buffer to 0
     memset(pFramesOut, 0, frameCount*pDevice->playback.channels*ma_get_bytes_per_sample(pDevice->playback.format));
 
-    // Using a mutex here for thread-safety which makes things not real-time
-    // This is unlikely to be necessary for this project, but may want to consider how you might want to avoid this
-    ma_mutex_lock(&AUDIO.System.lock);
+    // Apply game thread commands before mixing, no lock is taken on the audio thread
+    // NOTE: Buffers list, active buffers, processors chains and playing state are only modified here
+    ProcessAudioCommands();
+
+    // Only playing buffers are visited, walked backwards because a buffer
+    // stopping while mixed is replaced in the array by the last one (already mixed)
+    for (int i = AUDIO.Buffer.activeCount - 1; i >= 0; i--)
     {
-        for (AudioBuffer *audioBuffer = AUDIO.Buffer.first; audioBuffer != NULL; audioBuffer = audioBuffer->next)
+        AudioBuffer *audioBuffer = AUDIO.Buffer.active[i];
+
+        // Ignore paused sounds
+        if (audioBuffer->paused) continue;
+
+        ma_uint32 framesRead = 0;
+
+        while (1)
         {
-            // Ignore stopped or paused sounds
-            if (!audioBuffer->playing || audioBuffer->paused) continue;
+            if (framesRead >= frameCount) break;
 
-            ma_uint32 framesRead = 0;
+            // Just read as much data as we can from the stream
+            ma_uint32 framesToRead = (frameCount - framesRead);
 
-            while (1)
+            while (framesToRead > 0)
             {
-                if (framesRead >= frameCount) break;
+                float tempBuffer[1024] = { 0 }; // Frames for stereo
 
-                // Just read as much data as we can from the stream
-                ma_uint32 framesToRead = (frameCount - framesRead);
+                ma_uint32 framesToReadRightNow = framesToRead;
+                if (framesToReadRightNow > sizeof(tempBuffer)/sizeof(tempBuffer[0])/AUDIO_DEVICE_CHANNELS)
+                {
+                    framesToReadRightNow = sizeof(tempBuffer)/sizeof(tempBuffer[0])/AUDIO_DEVICE_CHANNELS;
+                }
 
-                while (framesToRead > 0)
+                ma_uint32 framesJustRead = ReadAudioBufferFramesInMixingFormat(audioBuffer, tempBuffer, framesToReadRightNow);
+                if (framesJustRead > 0)
                 {
-                    float tempBuffer[1024] = { 0 }; // Frames for stereo
+                    float *framesOut = (float *)pFramesOut + (framesRead*AUDIO.System.device.playback.channels);
+                    float *framesIn = tempBuffer;
 
-                    ma_uint32 framesToReadRightNow = framesToRead;
-                    if (framesToReadRightNow > sizeof(tempBuffer)/sizeof(tempBuffer[0])/AUDIO_DEVICE_CHANNELS)
+                    // Apply processors chain if defined
+                    rAudioProcessor *processor = audioBuffer->processor;
+                    while (processor)
                     {
-                        framesToReadRightNow = sizeof(tempBuffer)/sizeof(tempBuffer[0])/AUDIO_DEVICE_CHANNELS;
+                        processor->process(framesIn, framesJustRead);
+                        processor = processor->next;
                     }
 
-                    ma_uint32 framesJustRead = ReadAudioBufferFramesInMixingFormat(audioBuffer, tempBuffer, framesToReadRightNow);
-                    if (framesJustRead > 0)
-                    {
-                        float *framesOut = (float *)pFramesOut + (framesRead*AUDIO.System.device.playback.channels);
-                        float *framesIn = tempBuffer;
+                    MixAudioFrames(framesOut, framesIn, framesJustRead, audioBuffer);
 
-                        // Apply processors chain if defined
-                        rAudioProcessor *processor = audioBuffer->processor;
-                        while (processor)
-                        {
-                            processor->process(framesIn, framesJustRead);
-                            processor = processor->next;
-                        }
-
-                        MixAudioFrames(framesOut, framesIn, framesJustRead, audioBuffer);
+                    framesToRead -= framesJustRead;
+                    framesRead += framesJustRead;
+                }
 
-                        framesToRead -= framesJustRead;
-                        framesRead += framesJustRead;
-                    }
+                if (!audioBuffer->playing)
+                {
+                    framesRead = frameCount;
+                    break;
+                }
 
-                    if (!audioBuffer->playing)
+                // If we weren't able to read all the frames we requested, break
+                if (framesJustRead < framesToReadRightNow)
+                {
+                    if (!audioBuffer->looping)
                     {
-                        framesRead = frameCount;
+                        ResetAudioBuffer(audioBuffer);
                         break;
                     }
-
-                    // If we weren't able to read all the frames we requested, break
-                    if (framesJustRead < framesToReadRightNow)
+                    else
                     {
-                        if (!audioBuffer->looping)
-                        {
-                            StopAudioBuffer(audioBuffer);
-                            break;
-                        }
-                        else
-                        {
-                            // Should never get here, but just for safety,
-                            // move the cursor position back to the start and continue the loop
-                            audioBuffer->frameCursorPos = 0;
-                            continue;
-                        }
+                        // Should never get here, but just for safety,
+                        // move the cursor position back to the start and continue the loop
+                        audioBuffer->frameCursorPos = 0;
+                        continue;
                     }
                 }
-
-                // If for some reason we weren't able to read every frame we'll need to break from the loop
-                // Not doing this could theoretically put us into an infinite loop
-                if (framesToRead > 0) break;
             }
+
+            // If for some reason we weren't able to read every frame we'll need to break from the loop
+            // Not doing this could theoretically put us into an infinite loop
+            if (framesToRead > 0) break;
         }
     }
-
-    ma_mutex_unlock(&AUDIO.System.lock);
 }
 
 // Main mixing function, pretty simple in this project, just an accumulation
-// NOTE: framesOut is both an input and an output, it is initially filled with zeros outside of this function
+// NOTE: framesOut is both an input and an output, it is initially filled with zeros outside of this function.
+// Gains are ramped from the ones at the end of last mix, so volume and pan changes are smooth (no zipper noise)
 static void MixAudioFrames(float *framesOut, const float *framesIn, ma_uint32 frameCount, AudioBuffer *buffer)
 {
     const float localVolume = buffer->volume;
     const ma_uint32 channels = AUDIO.System.device.playback.channels;
+    float levels[2] = { localVolume, localVolume };
 
     if (channels == 2)  // We consider panning
     {
@@ -2393,34 +3503,72 @@ static void MixAudioFrames(float *framesOut, const float *framesIn, ma_uint32 fr
         const float right = 1.0f - left;
 
         // Fast sine approximation in [0..1] for pan law: y = 0.5f*x*(3 - x*x);
-        const float levels[2] = { localVolume*0.5f*left*(3.0f - left*left), localVolume*0.5f*right*(3.0f - right*right) };
+        levels[0] = localVolume*0.5f*left*(3.0f - left*left);
+        levels[1] = localVolume*0.5f*right*(3.0f - right*right);
+    }
 
-        float *frameOut = framesOut;
-        const float *frameIn = framesIn;
+    // Buffer just started playing, no ramp from previous gains
+    if (!buffer->mixGainSet)
+    {
+        buffer->mixGain[0] = levels[0];
+        buffer->mixGain[1] = levels[1];
+        buffer->mixGainSet = true;
+    }
 
-        for (ma_uint32 frame = 0; frame < frameCount; frame++)
-        {
-            frameOut[0] += (frameIn[0]*levels[0]);
-            frameOut[1] += (frameIn[1]*levels[1]);
+    // Gains step every two samples: one frame on stereo (left channel on even samples, right channel on odd samples)
+    const float pairsPerFrame = (float)channels/2.0f;
+    const float evenStep = (levels[0] - buffer->mixGain[0])/(frameCount*pairsPerFrame);
+    const float oddStep = (levels[1] - buffer->mixGain[1])/(frameCount*pairsPerFrame);
 
-            frameOut += 2;
-            frameIn += 2;
-        }
+    MixAudioSamples(framesOut, framesIn, frameCount*channels, buffer->mixGain[0], buffer->mixGain[1], evenStep, oddStep);
+
+    buffer->mixGain[0] = levels[0];
+    buffer->mixGain[1] = levels[1];
+}
+
+// Accumulate samples multiplied by gain: samplesOut[i] += samplesIn[i]*gain
+// NOTE: Even and odd samples use a different gain, so interleaved stereo can be panned in a single pass,
+// gains increase by step on every pair of samples, vector widths are even so the gains pattern never changes
+static void MixAudioSamples(float *samplesOut, const float *samplesIn, ma_uint32 sampleCount, float evenGain, float oddGain, float evenStep, float oddStep)
+{
+    ma_uint32 i = 0;
+
+#if defined(AUDIO_MIX_AVX)
+    __m256 gain8 = _mm256_setr_ps(evenGain, oddGain, evenGain + evenStep, oddGain + oddStep,
+                                  evenGain + 2.0f*evenStep, oddGain + 2.0f*oddStep, evenGain + 3.0f*evenStep, oddGain + 3.0f*oddStep);
+    const __m256 step8 = _mm256_setr_ps(4.0f*evenStep, 4.0f*oddStep, 4.0f*evenStep, 4.0f*oddStep, 4.0f*evenStep, 4.0f*oddStep, 4.0f*evenStep, 4.0f*oddStep);
+
+    for (; (i + 8) <= sampleCount; i += 8)
+    {
+        __m256 out = _mm256_loadu_ps(samplesOut + i);
+        out = _mm256_add_ps(out, _mm256_mul_ps(_mm256_loadu_ps(samplesIn + i), gain8));
+        _mm256_storeu_ps(samplesOut + i, out);
+        gain8 = _mm256_add_ps(gain8, step8);
     }
-    else  // We do not consider panning
+#endif
+#if defined(AUDIO_MIX_AVX) || defined(AUDIO_MIX_SSE)
+    // NOTE: Gains restart from sample i, computed from the initial ones to not accumulate rounding
+    const float pairs = (float)(i/2);
+    __m128 gain4 = _mm_setr_ps(evenGain + pairs*evenStep, oddGain + pairs*oddStep, evenGain + (pairs + 1.0f)*evenStep, oddGain + (pairs + 1.0f)*oddStep);
+    const __m128 step4 = _mm_setr_ps(2.0f*evenStep, 2.0f*oddStep, 2.0f*evenStep, 2.0f*oddStep);
+
+    for (; (i + 4) <= sampleCount; i += 4)
     {
-        for (ma_uint32 frame = 0; frame < frameCount; frame++)
-        {
-            for (ma_uint32 c = 0; c < channels; c++)
-            {
-                float *frameOut = framesOut + (frame*channels);
-                const float *frameIn = framesIn + (frame*channels);
+        __m128 out = _mm_loadu_ps(samplesOut + i);
+        out = _mm_add_ps(out, _mm_mul_ps(_mm_loadu_ps(samplesIn + i), gain4));
+        _mm_storeu_ps(samplesOut + i, out);
+        gain4 = _mm_add_ps(gain4, step4);
+    }
+#endif
 
-                // Output accumulates input multiplied by volume to provided output (usually 0)
-                frameOut[c] += (frameIn[c]*localVolume);
-            }
-        }
+    // Scalar fallback, also processes remaining samples
+    for (; (i + 2) <= sampleCount; i += 2)
+    {
+        samplesOut[i] += samplesIn[i]*(evenGain + (i/2)*evenStep);
+        samplesOut[i + 1] += samplesIn[i + 1]*(oddGain + (i/2)*oddStep);
     }
+
+    if (i < sampleCount) samplesOut[i] += samplesIn[i]*(evenGain + (i/2)*evenStep);
 }
 
 // Some required functions for audio standalone module version
@@ -897,6 +897,14 @@ typedef enum {
     NPATCH_THREE_PATCH_HORIZONTAL   // Npatch layout: 3x1 tiles
 } NPatchLayout;
 
+// Audio resampler modes
+// NOTE: Resampler is used on sample rate conversion and pitch changes
+typedef enum {
+    AUDIO_RESAMPLER_NEAREST = 0,    // No interpolation, just nearest frame (fastest)
+    AUDIO_RESAMPLER_LINEAR,         // Linear interpolation (default)
+    AUDIO_RESAMPLER_SINC            // Windowed-sinc interpolation (best quality)
+} AudioResampler;
+
 // Callbacks to hook some internal functions
 // WARNING: This callbacks are intended for advance users
 typedef void (*TraceLogCallback)(int logLevel, const char *text, va_list args);  // Logging: Redirect trace log messages
@@ -1181,6 +1189,7 @@ RLAPI void DrawCircleSector(Vector2 center, float radius, float startAngle, floa
 RLAPI void DrawCircleSectorLines(Vector2 center, float radius, float startAngle, float endAngle, int segments, Color color); // Draw circle sector outline
 RLAPI void DrawCircleGradient(int centerX, int centerY, float radius, Color color1, Color color2);       // Draw a gradient-filled circle
 RLAPI void DrawCircleV(Vector2 center, float radius, Color color);                                       // Draw a color-filled circle (Vector version)
+RLAPI void DrawCircleBatch(Vector2 *centers, float *radius, Color *colors, int count);                  // Draw multiple color-filled circles, a single quad per circle
 RLAPI void DrawCircleLines(int centerX, int centerY, float radius, Color color);                         // Draw circle outline
 RLAPI void DrawEllipse(int centerX, int centerY, float radiusH, float radiusV, Color color);             // Draw ellipse
 RLAPI void DrawEllipseLines(int centerX, int centerY, float radiusH, float radiusV, Color color);        // Draw ellipse outline
@@ -1246,6 +1255,8 @@ RLAPI Image ImageCopy(Image image);
 RLAPI Image ImageFromImage(Image image, Rectangle rec);                                                  // Create an image from another image piece
 RLAPI Image ImageText(const char *text, int fontSize, Color color);                                      // Create an image from text (default font)
 RLAPI Image ImageTextEx(Font font, const char *text, float fontSize, float spacing, Color tint);         // Create an image from text (custom sprite font)
+RLAPI Image GenImageAtlas(const Image *images, int imageCount, int padding, Rectangle **recs);            // Create an atlas image packing multiple images, recs returns images position in atlas
+RLAPI void UnloadImageAtlasRecs(Rectangle *recs);                                                        // Unload image atlas rectangles loaded with GenImageAtlas()
 RLAPI void ImageFormat(Image *image, int newFormat);                                                     // Convert image data to desired format
 RLAPI void ImageToPOT(Image *image, Color fill);                                                         // Convert image to POT (power-of-two)
 RLAPI void ImageCrop(Image *image, Rectangle crop);                                                      // Crop an image to a defined rectangle
@@ -1284,6 +1295,8 @@ RLAPI void ImageDrawLine(Image *dst, int startPosX, int startPosY, int endPosX,
 RLAPI void ImageDrawLineV(Image *dst, Vector2 start, Vector2 end, Color color);                          // Draw line within an image (Vector version)
 RLAPI void ImageDrawCircle(Image *dst, int centerX, int centerY, int radius, Color color);               // Draw circle within an image
 RLAPI void ImageDrawCircleV(Image *dst, Vector2 center, int radius, Color color);                        // Draw circle within an image (Vector version)
+RLAPI void ImageDrawCircleFilled(Image *dst, int centerX, int centerY, int radius, Color color);         // Draw filled circle within an image
+RLAPI void ImageDrawCircleFilledV(Image *dst, Vector2 center, int radius, Color color);                  // Draw filled circle within an image (Vector version)
 RLAPI void ImageDrawRectangle(Image *dst, int posX, int posY, int width, int height, Color color);       // Draw rectangle within an image
 RLAPI void ImageDrawRectangleV(Image *dst, Vector2 position, Vector2 size, Color color);                 // Draw rectangle within an image (Vector version)
 RLAPI void ImageDrawRectangleRec(Image *dst, Rectangle rec, Color color);                                // Draw rectangle within an image
@@ -1492,9 +1505,12 @@ typedef void (*AudioCallback)(void *bufferData, unsigned int frames);
 
 // Audio device management functions
 RLAPI void InitAudioDevice(void);                                     // Initialize audio device and context
+RLAPI void InitAudioDeviceOffline(int sampleRate);                    // Initialize audio context without playback device (mixed on demand)
 RLAPI void CloseAudioDevice(void);                                    // Close the audio device and context
 RLAPI bool IsAudioDeviceReady(void);                                  // Check if audio device has been initialized successfully
 RLAPI void SetMasterVolume(float volume);                             // Set master volume (listener)
+RLAPI void RenderAudioFrames(float *frames, int frameCount);          // Render audio mix into float frames buffer (offline device only)
+RLAPI Wave RenderAudioWave(int frameCount);                           // Render audio mix into a new wave (offline device only)
 
 // Wave/Sound loading/unloading functions
 RLAPI Wave LoadWave(const char *fileName);                            // Load wave data from file
@@ -1513,12 +1529,14 @@ RLAPI void StopSound(Sound sound);                                    // Stop pl
 RLAPI void PauseSound(Sound sound);                                   // Pause a sound
 RLAPI void ResumeSound(Sound sound);                                  // Resume a paused sound
 RLAPI void PlaySoundMulti(Sound sound);                               // Play a sound (using multichannel buffer pool)
+RLAPI void SetSoundMaxVoices(Sound sound, int maxVoices);             // Set max voices playing a sound in multichannel buffer pool (0 is unlimited)
 RLAPI void StopSoundMulti(void);                                      // Stop any sound playing (using multichannel buffer pool)
 RLAPI int GetSoundsPlaying(void);                                     // Get number of sounds playing in the multichannel
 RLAPI bool IsSoundPlaying(Sound sound);                               // Check if a sound is currently playing
 RLAPI void SetSoundVolume(Sound sound, float volume);                 // Set volume for a sound (1.0 is max level)
 RLAPI void SetSoundPitch(Sound sound, float pitch);                   // Set pitch for a sound (1.0 is base level)
 RLAPI void SetSoundPan(Sound sound, float pan);                       // Set pan for a sound (0.5 is center)
+RLAPI void SetSoundResampler(Sound sound, int resampler);             // Set resampler mode for a sound (AudioResampler)
 RLAPI Wave WaveCopy(Wave wave);                                       // Copy a wave to a new wave
 RLAPI void WaveCrop(Wave *wave, int initSample, int finalSample);     // Crop a wave to defined samples range
 RLAPI void WaveFormat(Wave *wave, int sampleRate, int sampleSize, int channels); // Convert wave data to desired format
@@ -1531,7 +1549,7 @@ RLAPI Music LoadMusicStreamFromMemory(const char *fileType, const unsigned char
 RLAPI void UnloadMusicStream(Music music);                            // Unload music stream
 RLAPI void PlayMusicStream(Music music);                              // Start music playing
 RLAPI bool IsMusicStreamPlaying(Music music);                         // Check if music is playing
-RLAPI void UpdateMusicStream(Music music);                            // Updates buffers for music streaming
+RLAPI void UpdateMusicStream(Music music);                            // Updates music stream looping (music is decoded on its own thread)
 RLAPI void StopMusicStream(Music music);                              // Stop music playing
 RLAPI void PauseMusicStream(Music music);                             // Pause music playing
 RLAPI void ResumeMusicStream(Music music);                            // Resume playing paused music
@@ -1541,6 +1559,7 @@ RLAPI void SetMusicPitch(Music music, float pitch);                   // Set pit
 RLAPI void SetMusicPan(Music music, float pan);                       // Set pan for a music (0.5 is center)
 RLAPI float GetMusicTimeLength(Music music);                          // Get music time length (in seconds)
 RLAPI float GetMusicTimePlayed(Music music);                          // Get current music time played (in seconds)
+RLAPI unsigned int GetMusicStreamUnderruns(Music music);              // Get number of times music playback ran out of decoded data
 
 // AudioStream management functions
 RLAPI AudioStream LoadAudioStream(unsigned int sampleRate, unsigned int sampleSize, unsigned int channels); // Load audio stream (to stream raw audio pcm data)
@@ -604,6 +604,9 @@ static bool eventsRecording = false;    // Record events
 extern void LoadFontDefault(void);          // [Module: text] Loads default font on InitWindow()
 extern void UnloadFontDefault(void);        // [Module: text] Unloads default font from GPU memory
 #endif
+#if defined(SUPPORT_MODULE_RSHAPES)
+extern void UnloadShapesDefault(void);      // [Module: shapes] Unloads shapes default data (circle shader, tessellation buffers)
+#endif
 
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
@@ -936,6 +939,10 @@ void CloseWindow(void)
     UnloadFontDefault();        // WARNING: Module required: rtext
 #endif
 
+#if defined(SUPPORT_MODULE_RSHAPES)
+    UnloadShapesDefault();      // WARNING: Module required: rshapes
+#endif
+
     rlglClose();                // De-init rlgl
 
 #if defined(PLATFORM_DESKTOP) || defined(PLATFORM_WEB)
@@ -2090,6 +2097,8 @@ void EndDrawing(void)
     }
 #endif
 
+    rlResetDrawStats();             // Keep draw statistics of this frame
+
 #if !defined(SUPPORT_CUSTOM_FRAME_CONTROL)
     SwapScreenBuffer();                  // Copy back buffer to front buffer (screen)
 
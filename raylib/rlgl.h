@@ -30,6 +30,10 @@
 *       Those preprocessor defines are only used on rlgl module, if OpenGL version is
 *       required by any other module, use rlGetVersion() to check it
 *
+*   #define GRAPHICS_API_OPENGL_11_SOFTWARE
+*       Use OpenGL 1.1 backend on rlsw software rasterizer (rlsw.h), no GPU or OpenGL driver required,
+*       framebuffer is rasterized on CPU and can be read with rlReadScreenPixels()
+*
 *   #define RLGL_IMPLEMENTATION
 *       Generates the implementation of the library into the included file.
 *       If not defined, the library is in header only mode and can be included in other headers
@@ -45,6 +49,11 @@
 *   #define RLGL_ENABLE_OPENGL_DEBUG_CONTEXT
 *       Enable debug context (only available on OpenGL 4.3)
 *
+*   #define RLGL_ORPHAN_BATCH_BUFFERS
+*       Orphan render batch buffers storage before every update, the driver hands out new storage
+*       instead of waiting (stall) for the GPU to finish drawing with previous batch data.
+*       Works best combined with RL_DEFAULT_BATCH_BUFFERS > 1
+*
 *   rlgl capabilities could be customized just defining some internal
 *   values before library inclusion (default values listed):
 *
@@ -144,6 +153,11 @@
     #define RL_FREE(p)        free(p)
 #endif
 
+// Software rasterizer implements OpenGL 1.1 functionality
+#if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+    #define GRAPHICS_API_OPENGL_11
+#endif
+
 // Security check in case no GRAPHICS_API_OPENGL_* defined
 #if !defined(GRAPHICS_API_OPENGL_11) && \
     !defined(GRAPHICS_API_OPENGL_21) && \
@@ -342,6 +356,7 @@ typedef struct rlDrawCall {
     //unsigned int vaoId;       // Vertex array id to be used on the draw -> Using RLGL.currentBatch->vertexBuffer.vaoId
     //unsigned int shaderId;    // Shader id to be used on the draw -> Using RLGL.currentShaderId
     unsigned int textureId;     // Texture id to be used on the draw -> Use to create new draw call if changes
+    int layer;                  // Draw layer, used to sort draws (if draw sorting enabled) -> Use to create new draw call if changes
 
     //Matrix projection;      // Projection matrix for this draw -> Using RLGL.projection by default
     //Matrix modelview;       // Modelview matrix for this draw -> Using RLGL.modelview by default
@@ -365,6 +380,27 @@ typedef struct rlRenderBatch {
 typedef enum bool { false = 0, true = !false } bool;
 #endif
 
+// Static render batch type
+// NOTE: Retained batch, draw calls are recorded once and replayed, vertex data
+// is only uploaded to GPU when batch is dirty (after a new recording),
+// only available on OpenGL 3.3 and ES2 backends
+typedef struct rlStaticBatch {
+    rlRenderBatch batch;        // Retained render batch (single buffer)
+    int vertexCount;            // Number of vertex recorded
+    bool dirty;                 // Vertex data requires GPU upload
+} rlStaticBatch;
+
+// Draw statistics type
+// NOTE: Counted for OpenGL 3.3 and ES2 backends, values are per frame
+typedef struct rlDrawStats {
+    int batches;                // Render batches drawn (default batch flushes and static batches)
+    int forcedBatches;          // Render batches drawn because batch limits were reached
+    int drawCalls;              // Draw calls issued (glDrawArrays()/glDrawElements())
+    int vertexCount;            // Vertex drawn
+    int textureChanges;         // Texture changes within render batches (new draw call required)
+    int uploadBytes;            // Batch vertex data uploaded to GPU (bytes)
+} rlDrawStats;
+
 #if !defined(RL_MATRIX_TYPE)
 // Matrix, 4x4 components, column major, OpenGL style, right handed
 typedef struct Matrix {
@@ -618,6 +654,27 @@ RLAPI void rlDrawRenderBatchActive(void);                                   // U
 RLAPI bool rlCheckRenderBatchLimit(int vCount);                             // Check internal buffer overflow for a given number of vertex
 RLAPI void rlSetTexture(unsigned int id);           // Set current texture for render batch and check buffers limits
 
+// Static render batch management
+// NOTE: Recording must not change render state (shader, blending, matrix mode) and must fit batch limits,
+// only available on OpenGL 3.3 and ES2 backends, OpenGL 1.1 draws immediately while recording and replays nothing
+RLAPI rlStaticBatch rlLoadStaticBatch(int bufferElements);                  // Load a static render batch
+RLAPI void rlUnloadStaticBatch(rlStaticBatch batch);                        // Unload static render batch
+RLAPI void rlBeginStaticBatch(rlStaticBatch *batch);                        // Begin recording draw calls into static batch (previous content discarded)
+RLAPI void rlEndStaticBatch(void);                                          // End recording draw calls into static batch
+RLAPI void rlDrawStaticBatch(rlStaticBatch *batch);                         // Draw static batch, vertex data only uploaded if dirty
+
+// Draw sorting
+// NOTE: Draws are sorted by layer, texture and mode when the batch is drawn to reduce state changes,
+// within a layer draws order is only changed for draws not overlapping on screen, so blending is not affected,
+// consecutive draws with same texture and mode are merged, stereo rendering keeps order within a layer
+RLAPI void rlEnableDrawSorting(void);                                       // Enable render batch draws sorting
+RLAPI void rlDisableDrawSorting(void);                                      // Disable render batch draws sorting
+RLAPI void rlSetDrawLayer(int layer);                                       // Set draw layer for next draws, lower layers drawn first
+
+// Draw statistics
+RLAPI rlDrawStats rlGetDrawStats(void);                                     // Get draw statistics of last frame
+RLAPI void rlResetDrawStats(void);                                          // Store current frame draw statistics and reset counters (called on EndDrawing())
+
 //------------------------------------------------------------------------------------------------------------------------
 
 // Vertex buffers management
@@ -711,7 +768,16 @@ RLAPI void rlLoadDrawQuad(void);     // Load and draw a quad
 
 #if defined(RLGL_IMPLEMENTATION)
 
-#if defined(GRAPHICS_API_OPENGL_11)
+#if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+    #define SW_MALLOC(sz)       RL_MALLOC(sz)
+    #define SW_CALLOC(n,sz)     RL_CALLOC(n,sz)
+    #define SW_REALLOC(ptr,sz)  RL_REALLOC(ptr,sz)
+    #define SW_FREE(ptr)        RL_FREE(ptr)
+
+    #define RLSW_IMPLEMENTATION
+    #define RLSW_GL_NAMES
+    #include "rlsw.h"                   // OpenGL 1.1 functionality on software rasterizer
+#elif defined(GRAPHICS_API_OPENGL_11)
     #if defined(__APPLE__)
         #include <OpenGL/gl.h>          // OpenGL 1.1 library for OSX
         #include <OpenGL/glext.h>       // OpenGL extensions library
@@ -823,7 +889,7 @@ RLAPI void rlLoadDrawQuad(void);     // Load and draw a quad
     #define GL_TEXTURE_MAX_ANISOTROPY_EXT       0x84FE
 #endif
 
-#if defined(GRAPHICS_API_OPENGL_11)
+#if defined(GRAPHICS_API_OPENGL_11) && !defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
     #define GL_UNSIGNED_SHORT_5_6_5             0x8363
     #define GL_UNSIGNED_SHORT_5_5_5_1           0x8034
     #define GL_UNSIGNED_SHORT_4_4_4_4           0x8033
@@ -895,6 +961,10 @@ RLAPI void rlLoadDrawQuad(void);     // Load and draw a quad
 typedef struct rlglData {
     rlRenderBatch *currentBatch;            // Current render batch
     rlRenderBatch defaultBatch;             // Default internal render batch
+    rlStaticBatch *staticBatch;             // Static render batch being recorded (NULL if not recording)
+    rlRenderBatch *staticPrevBatch;         // Active render batch before static batch recording
+    rlDrawStats stats;                      // Draw statistics of current frame
+    rlDrawStats lastStats;                  // Draw statistics of last frame
 
     struct {
         int vertexCounter;                  // Current active render batch vertex counter (generic, used for all batches)
@@ -932,6 +1002,13 @@ typedef struct rlglData {
         int framebufferWidth;               // Current framebuffer width
         int framebufferHeight;              // Current framebuffer height
 
+        bool sortDraws;                     // Sort render batch draws before drawing
+        int drawLayer;                      // Current draw layer
+        int sortBufferSize;                 // Vertex capacity of sort buffers
+        float *sortVertices;                // Vertex position copy used on draws sorting
+        float *sortTexcoords;               // Vertex texcoords copy used on draws sorting
+        unsigned char *sortColors;          // Vertex colors copy used on draws sorting
+
     } State;            // Renderer state
     struct {
         bool vao;                           // VAO support (OpenGL ES2 could not support VAO extension) (GL_ARB_vertex_array_object)
@@ -984,6 +1061,11 @@ static PFNGLVERTEXATTRIBDIVISOREXTPROC glVertexAttribDivisor = NULL;
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 static void rlLoadShaderDefault(void);      // Load default shader
 static void rlUnloadShaderDefault(void);    // Unload default shader
+static void rlUpdateRenderBatchBuffers(rlRenderBatch *batch, int vertexCount);   // Upload batch vertex data to GPU
+static void rlDrawRenderBatchBuffers(rlRenderBatch *batch, int vertexCount);     // Draw batch vertex buffers (considering VR stereo)
+static void rlResetRenderBatch(rlRenderBatch *batch);                            // Reset batch draw calls for next recording
+static void rlSortRenderBatch(rlRenderBatch *batch);                             // Sort batch draw calls by layer, texture and mode
+static int rlGetDrawCallAlignment(rlDrawCall draw);                              // Get vertex alignment required after a draw call
 #if defined(RLGL_SHOW_GL_DETAILS_INFO)
 static char *rlGetCompressedFormatName(int format); // Get compressed format official GL identifier name
 #endif  // RLGL_SHOW_GL_DETAILS_INFO
@@ -1291,11 +1373,16 @@ void rlBegin(int mode)
             }
         }
 
-        if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+        if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+        {
+            RLGL.stats.forcedBatches++;
+            rlDrawRenderBatch(RLGL.currentBatch);
+        }
 
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode = mode;
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId = RLGL.State.defaultTextureId;
+        RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].layer = RLGL.State.drawLayer;
     }
 }
 
@@ -1315,6 +1402,7 @@ void rlEnd(void)
         // we need to call rlPopMatrix() before to recover *RLGL.State.currentMatrix (RLGL.State.modelview) for the next forced draw call!
         // If we have multiple matrix pushed, it will require "RLGL.State.stackCounter" pops before launching the draw
         for (int i = RLGL.State.stackCounter; i >= 0; i--) rlPopMatrix();
+        RLGL.stats.forcedBatches++;
         rlDrawRenderBatch(RLGL.currentBatch);
     }
 }
@@ -1431,6 +1519,7 @@ void rlSetTexture(unsigned int id)
         if (RLGL.State.vertexCounter >=
             RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementCount*4)
         {
+            RLGL.stats.forcedBatches++;
             rlDrawRenderBatch(RLGL.currentBatch);
         }
 #endif
@@ -1442,6 +1531,8 @@ void rlSetTexture(unsigned int id)
 #else
         if (RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId != id)
         {
+            RLGL.stats.textureChanges++;
+
             if (RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount > 0)
             {
                 // Make sure current RLGL.currentBatch->draws[i].vertexCount is aligned a multiple of 4,
@@ -1461,10 +1552,15 @@ void rlSetTexture(unsigned int id)
                 }
             }
 
-            if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+            if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+            {
+                RLGL.stats.forcedBatches++;
+                rlDrawRenderBatch(RLGL.currentBatch);
+            }
 
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId = id;
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
+            RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].layer = RLGL.State.drawLayer;
         }
 #endif
     }
@@ -1879,6 +1975,12 @@ static void GLAPIENTRY rlDebugMessageCallback(GLenum source, GLenum type, GLuint
 // Initialize rlgl: OpenGL extensions, default buffers/shaders/textures, OpenGL states
 void rlglInit(int width, int height)
 {
+#if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+    // Init software rasterizer framebuffer, replaces OpenGL context
+    if (swInit(width, height)) TRACELOG(RL_LOG_INFO, "RLGL: Software rasterizer initialized successfully (%i x %i)", width, height);
+    else TRACELOG(RL_LOG_WARNING, "RLGL: Failed to initialize software rasterizer");
+#endif
+
     // Enable OpenGL debug context if required
 #if defined(RLGL_ENABLE_OPENGL_DEBUG_CONTEXT) && defined(GRAPHICS_API_OPENGL_43)
     if ((glDebugMessageCallback != NULL) && (glDebugMessageControl != NULL))
@@ -1970,11 +2072,20 @@ void rlglClose(void)
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     rlUnloadRenderBatch(RLGL.defaultBatch);
 
+    // Unload draws sorting buffers (if used)
+    RL_FREE(RLGL.State.sortVertices);
+    RL_FREE(RLGL.State.sortTexcoords);
+    RL_FREE(RLGL.State.sortColors);
+
     rlUnloadShaderDefault();          // Unload default shader
 
     glDeleteTextures(1, &RLGL.State.defaultTextureId); // Unload default texture
     TRACELOG(RL_LOG_INFO, "TEXTURE: [ID %i] Default texture unloaded successfully", RLGL.State.defaultTextureId);
 #endif
+
+#if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+    swClose();                        // Close software rasterizer, framebuffer and textures freed
+#endif
 }
 
 // Load OpenGL extensions
@@ -2469,192 +2580,29 @@ void rlUnloadRenderBatch(rlRenderBatch batch)
 void rlDrawRenderBatch(rlRenderBatch *batch)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    // Update batch vertex buffers
-    //------------------------------------------------------------------------------------------------------------
-    // NOTE: If there is not vertex data, buffers doesn't need to be updated (vertexCount > 0)
-    // TODO: If no data changed on the CPU arrays --> No need to re-update GPU arrays (change flag required)
-    if (RLGL.State.vertexCounter > 0)
+    if ((RLGL.staticBatch != NULL) && (batch == &RLGL.staticBatch->batch))
     {
-        // Activate elements VAO
-        if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
-
-        // Vertex positions buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].vertices, GL_DYNAMIC_DRAW);  // Update all buffer
-
-        // Texture coordinates buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*2*sizeof(float), batch->vertexBuffer[batch->currentBuffer].texcoords);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].texcoords, GL_DYNAMIC_DRAW); // Update all buffer
-
-        // Colors buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*4*sizeof(unsigned char), batch->vertexBuffer[batch->currentBuffer].colors);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].colors, GL_DYNAMIC_DRAW);    // Update all buffer
-
-        // NOTE: glMapBuffer() causes sync issue.
-        // If GPU is working with this buffer, glMapBuffer() will wait(stall) until GPU to finish its job.
-        // To avoid waiting (idle), you can call first glBufferData() with NULL pointer before glMapBuffer().
-        // If you do that, the previous data in PBO will be discarded and glMapBuffer() returns a new
-        // allocated pointer immediately even if GPU is still working with the previous data.
-
-        // Another option: map the buffer object into client's memory
-        // Probably this code could be moved somewhere else...
-        // batch->vertexBuffer[batch->currentBuffer].vertices = (float *)glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
-        // if (batch->vertexBuffer[batch->currentBuffer].vertices)
-        // {
-            // Update vertex data
-        // }
-        // glUnmapBuffer(GL_ARRAY_BUFFER);
-
-        // Unbind the current VAO
-        if (RLGL.ExtSupported.vao) glBindVertexArray(0);
+        // NOTE: Static batch can not be flushed while recording (batch limits reached or render state changed),
+        // recorded draws are discarded and recording continues from an empty batch
+        TRACELOG(RL_LOG_WARNING, "RLGL: Static batch flushed while recording, recorded draws discarded");
     }
-    //------------------------------------------------------------------------------------------------------------
-
-    // Draw batch vertex buffers (considering VR stereo if required)
-    //------------------------------------------------------------------------------------------------------------
-    Matrix matProjection = RLGL.State.projection;
-    Matrix matModelView = RLGL.State.modelview;
-
-    int eyeCount = 1;
-    if (RLGL.State.stereoRender) eyeCount = 2;
-
-    for (int eye = 0; eye < eyeCount; eye++)
+    else
     {
-        if (eyeCount == 2)
-        {
-            // Setup current eye viewport (half screen width)
-            rlViewport(eye*RLGL.State.framebufferWidth/2, 0, RLGL.State.framebufferWidth/2, RLGL.State.framebufferHeight);
-
-            // Set current eye view offset to modelview matrix
-            rlSetMatrixModelview(rlMatrixMultiply(matModelView, RLGL.State.viewOffsetStereo[eye]));
-            // Set current eye projection matrix
-            rlSetMatrixProjection(RLGL.State.projectionStereo[eye]);
-        }
-
-        // Draw buffers
-        if (RLGL.State.vertexCounter > 0)
-        {
-            // Set current shader and upload current MVP matrix
-            glUseProgram(RLGL.State.currentShaderId);
-
-            // Create modelview-projection matrix and upload to shader
-            Matrix matMVP = rlMatrixMultiply(RLGL.State.modelview, RLGL.State.projection);
-            float matMVPfloat[16] = {
-                matMVP.m0, matMVP.m1, matMVP.m2, matMVP.m3,
-                matMVP.m4, matMVP.m5, matMVP.m6, matMVP.m7,
-                matMVP.m8, matMVP.m9, matMVP.m10, matMVP.m11,
-                matMVP.m12, matMVP.m13, matMVP.m14, matMVP.m15
-            };
-            glUniformMatrix4fv(RLGL.State.currentShaderLocs[RL_SHADER_LOC_MATRIX_MVP], 1, false, matMVPfloat);
-
-            if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
-            else
-            {
-                // Bind vertex attrib: position (shader-location = 0)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
-
-                // Bind vertex attrib: texcoord (shader-location = 1)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
-
-                // Bind vertex attrib: color (shader-location = 3)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
-
-                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[3]);
-            }
-
-            // Setup some default shader values
-            glUniform4f(RLGL.State.currentShaderLocs[RL_SHADER_LOC_COLOR_DIFFUSE], 1.0f, 1.0f, 1.0f, 1.0f);
-            glUniform1i(RLGL.State.currentShaderLocs[RL_SHADER_LOC_MAP_DIFFUSE], 0);  // Active default sampler2D: texture0
-
-            // Activate additional sampler textures
-            // Those additional textures will be common for all draw calls of the batch
-            for (int i = 0; i < RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS; i++)
-            {
-                if (RLGL.State.activeTextureId[i] > 0)
-                {
-                    glActiveTexture(GL_TEXTURE0 + 1 + i);
-                    glBindTexture(GL_TEXTURE_2D, RLGL.State.activeTextureId[i]);
-                }
-            }
-
-            // Activate default sampler2D texture0 (one texture is always active for default batch shader)
-            // NOTE: Batch system accumulates calls by texture0 changes, additional textures are enabled for all the draw calls
-            glActiveTexture(GL_TEXTURE0);
-
-            for (int i = 0, vertexOffset = 0; i < batch->drawCounter; i++)
-            {
-                // Bind current draw call texture, activated as GL_TEXTURE0 and binded to sampler2D texture0 by default
-                glBindTexture(GL_TEXTURE_2D, batch->draws[i].textureId);
-
-                if ((batch->draws[i].mode == RL_LINES) || (batch->draws[i].mode == RL_TRIANGLES)) glDrawArrays(batch->draws[i].mode, vertexOffset, batch->draws[i].vertexCount);
-                else
-                {
-#if defined(GRAPHICS_API_OPENGL_33)
-                    // We need to define the number of indices to be processed: elementCount*6
-                    // NOTE: The final parameter tells the GPU the offset in bytes from the
-                    // start of the index buffer to the location of the first index to process
-                    glDrawElements(GL_TRIANGLES, batch->draws[i].vertexCount/4*6, GL_UNSIGNED_INT, (GLvoid *)(vertexOffset/4*6*sizeof(GLuint)));
-#endif
-#if defined(GRAPHICS_API_OPENGL_ES2)
-                    glDrawElements(GL_TRIANGLES, batch->draws[i].vertexCount/4*6, GL_UNSIGNED_SHORT, (GLvoid *)(vertexOffset/4*6*sizeof(GLushort)));
-#endif
-                }
-
-                vertexOffset += (batch->draws[i].vertexCount + batch->draws[i].vertexAlignment);
-            }
-
-            if (!RLGL.ExtSupported.vao)
-            {
-                glBindBuffer(GL_ARRAY_BUFFER, 0);
-                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-            }
-
-            glBindTexture(GL_TEXTURE_2D, 0);    // Unbind textures
-        }
-
-        if (RLGL.ExtSupported.vao) glBindVertexArray(0); // Unbind VAO
+        if (RLGL.State.sortDraws) rlSortRenderBatch(batch);
 
-        glUseProgram(0);    // Unbind shader program
+        rlUpdateRenderBatchBuffers(batch, RLGL.State.vertexCounter);
+        rlDrawRenderBatchBuffers(batch, RLGL.State.vertexCounter);
     }
 
-    // Restore viewport to default measures
-    if (eyeCount == 2) rlViewport(0, 0, RLGL.State.framebufferWidth, RLGL.State.framebufferHeight);
-    //------------------------------------------------------------------------------------------------------------
-
     // Reset batch buffers
     //------------------------------------------------------------------------------------------------------------
     // Reset vertex counter for next frame
     RLGL.State.vertexCounter = 0;
 
-    // Reset depth for next draw
-    batch->currentDepth = -1.0f;
-
-    // Restore projection/modelview matrices
-    RLGL.State.projection = matProjection;
-    RLGL.State.modelview = matModelView;
-
-    // Reset RLGL.currentBatch->draws array
-    for (int i = 0; i < RL_DEFAULT_BATCH_DRAWCALLS; i++)
-    {
-        batch->draws[i].mode = RL_QUADS;
-        batch->draws[i].vertexCount = 0;
-        batch->draws[i].textureId = RLGL.State.defaultTextureId;
-    }
+    rlResetRenderBatch(batch);
 
     // Reset active texture units for next batch
     for (int i = 0; i < RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS; i++) RLGL.State.activeTextureId[i] = 0;
-
-    // Reset draws counter to one draw for the batch
-    batch->drawCounter = 1;
     //------------------------------------------------------------------------------------------------------------
 
     // Change to next buffer in the list (in case of multi-buffering)
@@ -2696,6 +2644,7 @@ bool rlCheckRenderBatchLimit(int vCount)
         int currentTexture = RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId;
 
         overflow = true;
+        RLGL.stats.forcedBatches++;
         rlDrawRenderBatch(RLGL.currentBatch);    // NOTE: Stereo rendering is checked inside
 
         // Restore state of last batch so we can continue adding vertices
@@ -2707,6 +2656,156 @@ bool rlCheckRenderBatchLimit(int vCount)
     return overflow;
 }
 
+// Load a static render batch
+rlStaticBatch rlLoadStaticBatch(int bufferElements)
+{
+    rlStaticBatch batch = { 0 };
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    batch.batch = rlLoadRenderBatch(1, bufferElements);
+#else
+    TRACELOG(RL_LOG_WARNING, "RLGL: Static batches not supported, draws are not retained");
+#endif
+
+    return batch;
+}
+
+// Unload static render batch
+void rlUnloadStaticBatch(rlStaticBatch batch)
+{
+    rlUnloadRenderBatch(batch.batch);
+}
+
+// Begin recording draw calls into static batch
+// NOTE: Draws are only recorded, not drawn, until rlDrawStaticBatch() is called
+void rlBeginStaticBatch(rlStaticBatch *batch)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    rlDrawRenderBatch(RLGL.currentBatch);   // Flush pending draws of active batch
+
+    rlResetRenderBatch(&batch->batch);      // Discard previous recording
+    batch->vertexCount = 0;
+    batch->dirty = true;
+
+    RLGL.staticPrevBatch = RLGL.currentBatch;
+    RLGL.staticBatch = batch;
+    RLGL.currentBatch = &batch->batch;
+#endif
+}
+
+// End recording draw calls into static batch
+void rlEndStaticBatch(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (RLGL.staticBatch != NULL)
+    {
+        RLGL.staticBatch->vertexCount = RLGL.State.vertexCounter;
+        RLGL.State.vertexCounter = 0;
+
+        RLGL.currentBatch = RLGL.staticPrevBatch;
+        RLGL.staticBatch = NULL;
+    }
+#endif
+}
+
+// Draw static batch
+// NOTE: Vertex data is only uploaded after a new recording, drawn with current shader and matrices
+void rlDrawStaticBatch(rlStaticBatch *batch)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (batch->vertexCount > 0)
+    {
+        rlDrawRenderBatch(RLGL.currentBatch);   // Keep draw order with pending draws of active batch
+
+        if (batch->dirty)
+        {
+            rlUpdateRenderBatchBuffers(&batch->batch, batch->vertexCount);
+            batch->dirty = false;
+        }
+
+        rlDrawRenderBatchBuffers(&batch->batch, batch->vertexCount);
+    }
+#endif
+}
+
+// Enable render batch draws sorting
+void rlEnableDrawSorting(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    RLGL.State.sortDraws = true;
+#endif
+}
+
+// Disable render batch draws sorting
+void rlDisableDrawSorting(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    RLGL.State.sortDraws = false;
+#endif
+}
+
+// Set draw layer for next draws
+// NOTE: A new draw call is registered if current one already contains vertex
+void rlSetDrawLayer(int layer)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (RLGL.State.drawLayer != layer)
+    {
+        RLGL.State.drawLayer = layer;
+
+        rlDrawCall *draw = &RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1];
+
+        if (draw->vertexCount > 0)
+        {
+            int mode = draw->mode;
+            unsigned int textureId = draw->textureId;
+
+            // Keep vertex aligned for next draw, same as rlBegin()/rlSetTexture()
+            draw->vertexAlignment = rlGetDrawCallAlignment(*draw);
+
+            if (!rlCheckRenderBatchLimit(draw->vertexAlignment))
+            {
+                RLGL.State.vertexCounter += draw->vertexAlignment;
+                RLGL.currentBatch->drawCounter++;
+            }
+
+            if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+            {
+                RLGL.stats.forcedBatches++;
+                rlDrawRenderBatch(RLGL.currentBatch);
+            }
+
+            RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode = mode;
+            RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId = textureId;
+            RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
+        }
+
+        RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].layer = layer;
+    }
+#endif
+}
+
+// Get draw statistics of last frame
+rlDrawStats rlGetDrawStats(void)
+{
+    rlDrawStats stats = { 0 };
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    stats = RLGL.lastStats;
+#endif
+    return stats;
+}
+
+// Store current frame draw statistics and reset counters
+void rlResetDrawStats(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    rlDrawStats stats = { 0 };
+
+    RLGL.lastStats = RLGL.stats;
+    RLGL.stats = stats;
+#endif
+}
+
 // Textures data management
 //-----------------------------------------------------------------------------------------
 // Convert image data to OpenGL texture (returns OpenGL valid Id)
@@ -4423,6 +4522,383 @@ static void rlUnloadShaderDefault(void)
     TRACELOG(RL_LOG_INFO, "SHADER: [ID %i] Default shader unloaded successfully", RLGL.State.defaultShaderId);
 }
 
+// Upload batch vertex data to GPU
+static void rlUpdateRenderBatchBuffers(rlRenderBatch *batch, int vertexCount)
+{
+    // NOTE: If there is not vertex data, buffers doesn't need to be updated (vertexCount > 0)
+    // NOTE: Default batch data changes on every draw, geometry that does not change can be
+    // recorded into a static batch (rlBeginStaticBatch()) to avoid re-uploading it
+    if (vertexCount > 0)
+    {
+        // Activate elements VAO
+        if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
+
+        // NOTE: Orphaning: glBufferData() with NULL pointer discards previous buffer storage, so driver
+        // does not need to wait (stall) for the GPU to finish drawing with it before glBufferSubData()
+        // Vertex positions buffer
+        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+#if defined(RLGL_ORPHAN_BATCH_BUFFERS)
+        glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, NULL, GL_DYNAMIC_DRAW);
+#endif
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vertexCount*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
+
+        // Texture coordinates buffer
+        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
+#if defined(RLGL_ORPHAN_BATCH_BUFFERS)
+        glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementCount, NULL, GL_DYNAMIC_DRAW);
+#endif
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vertexCount*2*sizeof(float), batch->vertexBuffer[batch->currentBuffer].texcoords);
+
+        // Colors buffer
+        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
+#if defined(RLGL_ORPHAN_BATCH_BUFFERS)
+        glBufferData(GL_ARRAY_BUFFER, sizeof(unsigned char)*4*4*batch->vertexBuffer[batch->currentBuffer].elementCount, NULL, GL_DYNAMIC_DRAW);
+#endif
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vertexCount*4*sizeof(unsigned char), batch->vertexBuffer[batch->currentBuffer].colors);
+
+        RLGL.stats.uploadBytes += vertexCount*(3*sizeof(float) + 2*sizeof(float) + 4*sizeof(unsigned char));
+
+        // NOTE: Persistent mapped buffers (glBufferStorage() + GL_MAP_PERSISTENT_BIT) would avoid the copy
+        // but require OpenGL 4.4, not available on OpenGL 3.3 and ES2 backends
+
+        // Another option: map the buffer object into client's memory
+        // Probably this code could be moved somewhere else...
+        // batch->vertexBuffer[batch->currentBuffer].vertices = (float *)glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
+        // if (batch->vertexBuffer[batch->currentBuffer].vertices)
+        // {
+            // Update vertex data
+        // }
+        // glUnmapBuffer(GL_ARRAY_BUFFER);
+
+        // Unbind the current VAO
+        if (RLGL.ExtSupported.vao) glBindVertexArray(0);
+    }
+}
+
+// Draw batch vertex buffers (considering VR stereo if required)
+static void rlDrawRenderBatchBuffers(rlRenderBatch *batch, int vertexCount)
+{
+    Matrix matProjection = RLGL.State.projection;
+    Matrix matModelView = RLGL.State.modelview;
+
+    int eyeCount = 1;
+    if (RLGL.State.stereoRender) eyeCount = 2;
+
+    for (int eye = 0; eye < eyeCount; eye++)
+    {
+        if (eyeCount == 2)
+        {
+            // Setup current eye viewport (half screen width)
+            rlViewport(eye*RLGL.State.framebufferWidth/2, 0, RLGL.State.framebufferWidth/2, RLGL.State.framebufferHeight);
+
+            // Set current eye view offset to modelview matrix
+            rlSetMatrixModelview(rlMatrixMultiply(matModelView, RLGL.State.viewOffsetStereo[eye]));
+            // Set current eye projection matrix
+            rlSetMatrixProjection(RLGL.State.projectionStereo[eye]);
+        }
+
+        // Draw buffers
+        if (vertexCount > 0)
+        {
+            RLGL.stats.batches++;
+
+            // Set current shader and upload current MVP matrix
+            glUseProgram(RLGL.State.currentShaderId);
+
+            // Create modelview-projection matrix and upload to shader
+            Matrix matMVP = rlMatrixMultiply(RLGL.State.modelview, RLGL.State.projection);
+            float matMVPfloat[16] = {
+                matMVP.m0, matMVP.m1, matMVP.m2, matMVP.m3,
+                matMVP.m4, matMVP.m5, matMVP.m6, matMVP.m7,
+                matMVP.m8, matMVP.m9, matMVP.m10, matMVP.m11,
+                matMVP.m12, matMVP.m13, matMVP.m14, matMVP.m15
+            };
+            glUniformMatrix4fv(RLGL.State.currentShaderLocs[RL_SHADER_LOC_MATRIX_MVP], 1, false, matMVPfloat);
+
+            if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
+            else
+            {
+                // Bind vertex attrib: position (shader-location = 0)
+                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
+                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
+
+                // Bind vertex attrib: texcoord (shader-location = 1)
+                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
+                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
+                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+
+                // Bind vertex attrib: color (shader-location = 3)
+                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
+                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
+
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[3]);
+            }
+
+            // Setup some default shader values
+            glUniform4f(RLGL.State.currentShaderLocs[RL_SHADER_LOC_COLOR_DIFFUSE], 1.0f, 1.0f, 1.0f, 1.0f);
+            glUniform1i(RLGL.State.currentShaderLocs[RL_SHADER_LOC_MAP_DIFFUSE], 0);  // Active default sampler2D: texture0
+
+            // Activate additional sampler textures
+            // Those additional textures will be common for all draw calls of the batch
+            for (int i = 0; i < RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS; i++)
+            {
+                if (RLGL.State.activeTextureId[i] > 0)
+                {
+                    glActiveTexture(GL_TEXTURE0 + 1 + i);
+                    glBindTexture(GL_TEXTURE_2D, RLGL.State.activeTextureId[i]);
+                }
+            }
+
+            // Activate default sampler2D texture0 (one texture is always active for default batch shader)
+            // NOTE: Batch system accumulates calls by texture0 changes, additional textures are enabled for all the draw calls
+            glActiveTexture(GL_TEXTURE0);
+
+            for (int i = 0, vertexOffset = 0; i < batch->drawCounter; i++)
+            {
+                // Bind current draw call texture, activated as GL_TEXTURE0 and binded to sampler2D texture0 by default
+                glBindTexture(GL_TEXTURE_2D, batch->draws[i].textureId);
+
+                if ((batch->draws[i].mode == RL_LINES) || (batch->draws[i].mode == RL_TRIANGLES)) glDrawArrays(batch->draws[i].mode, vertexOffset, batch->draws[i].vertexCount);
+                else
+                {
+#if defined(GRAPHICS_API_OPENGL_33)
+                    // We need to define the number of indices to be processed: elementCount*6
+                    // NOTE: The final parameter tells the GPU the offset in bytes from the
+                    // start of the index buffer to the location of the first index to process
+                    glDrawElements(GL_TRIANGLES, batch->draws[i].vertexCount/4*6, GL_UNSIGNED_INT, (GLvoid *)(vertexOffset/4*6*sizeof(GLuint)));
+#endif
+#if defined(GRAPHICS_API_OPENGL_ES2)
+                    glDrawElements(GL_TRIANGLES, batch->draws[i].vertexCount/4*6, GL_UNSIGNED_SHORT, (GLvoid *)(vertexOffset/4*6*sizeof(GLushort)));
+#endif
+                }
+
+                if (batch->draws[i].vertexCount > 0)
+                {
+                    RLGL.stats.drawCalls++;
+                    RLGL.stats.vertexCount += batch->draws[i].vertexCount;
+                }
+
+                vertexOffset += (batch->draws[i].vertexCount + batch->draws[i].vertexAlignment);
+            }
+
+            if (!RLGL.ExtSupported.vao)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            }
+
+            glBindTexture(GL_TEXTURE_2D, 0);    // Unbind textures
+        }
+
+        if (RLGL.ExtSupported.vao) glBindVertexArray(0); // Unbind VAO
+
+        glUseProgram(0);    // Unbind shader program
+    }
+
+    // Restore viewport to default measures
+    if (eyeCount == 2) rlViewport(0, 0, RLGL.State.framebufferWidth, RLGL.State.framebufferHeight);
+
+    // Restore projection/modelview matrices
+    RLGL.State.projection = matProjection;
+    RLGL.State.modelview = matModelView;
+}
+
+// Reset batch draw calls for next recording
+static void rlResetRenderBatch(rlRenderBatch *batch)
+{
+    // Reset depth for next draw
+    batch->currentDepth = -1.0f;
+
+    // Reset RLGL.currentBatch->draws array
+    for (int i = 0; i < RL_DEFAULT_BATCH_DRAWCALLS; i++)
+    {
+        batch->draws[i].mode = RL_QUADS;
+        batch->draws[i].vertexCount = 0;
+        batch->draws[i].textureId = RLGL.State.defaultTextureId;
+        batch->draws[i].layer = RLGL.State.drawLayer;
+    }
+
+    // Reset draws counter to one draw for the batch
+    batch->drawCounter = 1;
+}
+
+// Sort batch draw calls by layer, texture and mode
+// NOTE: Sorting is stable, draws only move past draws of the same layer they do not overlap on screen,
+// so blending result is not affected, consecutive draws sharing layer, texture and mode are merged
+// into one draw call, vertex data is reordered in place, a copy of the batch data is kept in sort buffers
+static void rlSortRenderBatch(rlRenderBatch *batch)
+{
+    int drawCount = batch->drawCounter;
+    if (drawCount < 2) return;
+
+    rlVertexBuffer *buffer = &batch->vertexBuffer[batch->currentBuffer];
+    int order[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };
+    int offsets[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };
+    float bounds[RL_DEFAULT_BATCH_DRAWCALLS][4] = { 0 };    // Screen bounds of every draw: minX, minY, maxX, maxY
+    bool sorted = true;
+
+    // NOTE: Batch vertex data shares the current modelview and projection, draws bounds are computed
+    // in normalized device coordinates, stereo rendering and vertex behind the camera get unbounded draws
+    Matrix matMVP = rlMatrixMultiply(RLGL.State.modelview, RLGL.State.projection);
+
+    for (int i = 0, offset = 0; i < drawCount; i++)
+    {
+        order[i] = i;
+        offsets[i] = offset;
+
+        bounds[i][0] = bounds[i][1] = 1.0e30f;
+        bounds[i][2] = bounds[i][3] = -1.0e30f;
+
+        for (int v = offset; v < offset + batch->draws[i].vertexCount; v++)
+        {
+            float x = buffer->vertices[v*3];
+            float y = buffer->vertices[v*3 + 1];
+            float z = buffer->vertices[v*3 + 2];
+            float w = matMVP.m3*x + matMVP.m7*y + matMVP.m11*z + matMVP.m15;
+
+            if (RLGL.State.stereoRender || (w <= 0.0f))
+            {
+                bounds[i][0] = bounds[i][1] = -1.0e30f;
+                bounds[i][2] = bounds[i][3] = 1.0e30f;
+                break;
+            }
+
+            float ndcX = (matMVP.m0*x + matMVP.m4*y + matMVP.m8*z + matMVP.m12)/w;
+            float ndcY = (matMVP.m1*x + matMVP.m5*y + matMVP.m9*z + matMVP.m13)/w;
+
+            if (ndcX < bounds[i][0]) bounds[i][0] = ndcX;
+            if (ndcY < bounds[i][1]) bounds[i][1] = ndcY;
+            if (ndcX > bounds[i][2]) bounds[i][2] = ndcX;
+            if (ndcY > bounds[i][3]) bounds[i][3] = ndcY;
+        }
+
+        offset += (batch->draws[i].vertexCount + batch->draws[i].vertexAlignment);
+    }
+
+    // Stable insertion sort of draw indices, at most RL_DEFAULT_BATCH_DRAWCALLS entries
+    // NOTE: A draw moves before a previous one of the same layer only if their bounds do not overlap,
+    // every pair changing relative order is checked when they get swapped
+    #define RL_DRAW_KEY_LESS(a, b) (((a).layer != (b).layer)? ((a).layer < (b).layer) : \
+        (((a).textureId != (b).textureId)? ((a).textureId < (b).textureId) : ((a).mode < (b).mode)))
+    #define RL_DRAW_OVERLAP(a, b) ((bounds[a][0] <= bounds[b][2]) && (bounds[b][0] <= bounds[a][2]) && \
+        (bounds[a][1] <= bounds[b][3]) && (bounds[b][1] <= bounds[a][3]))
+
+    for (int i = 1; i < drawCount; i++)
+    {
+        for (int j = i; j > 0; j--)
+        {
+            rlDrawCall draw = batch->draws[order[j]];
+            rlDrawCall previous = batch->draws[order[j - 1]];
+
+            if (!RL_DRAW_KEY_LESS(draw, previous)) break;
+            if ((draw.layer == previous.layer) && RL_DRAW_OVERLAP(order[j], order[j - 1])) break;
+
+            int temp = order[j];
+            order[j] = order[j - 1];
+            order[j - 1] = temp;
+            sorted = false;
+        }
+    }
+
+    #undef RL_DRAW_KEY_LESS
+    #undef RL_DRAW_OVERLAP
+
+    // Merging is only possible when draws with same state are not contiguous
+    if (sorted)
+    {
+        for (int i = 1; i < drawCount; i++)
+        {
+            if ((batch->draws[i].layer == batch->draws[i - 1].layer) &&
+                (batch->draws[i].textureId == batch->draws[i - 1].textureId) &&
+                (batch->draws[i].mode == batch->draws[i - 1].mode)) sorted = false;
+        }
+
+        if (sorted) return;
+    }
+
+    // Build sorted draws, each source draw gets its target offset in vertex data
+    rlDrawCall draws[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };
+    int targets[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };
+    int count = 0;
+    int counter = 0;
+
+    for (int i = 0; i < drawCount; i++)
+    {
+        rlDrawCall draw = batch->draws[order[i]];
+        if (draw.vertexCount == 0) continue;
+
+        if ((count > 0) && (draws[count - 1].layer == draw.layer) &&
+            (draws[count - 1].textureId == draw.textureId) && (draws[count - 1].mode == draw.mode))
+        {
+            draws[count - 1].vertexCount += draw.vertexCount;   // Merge with previous draw
+        }
+        else
+        {
+            if (count > 0)
+            {
+                draws[count - 1].vertexAlignment = rlGetDrawCallAlignment(draws[count - 1]);
+                counter += draws[count - 1].vertexAlignment;
+            }
+
+            draw.vertexAlignment = 0;   // Last draw is not aligned, no draw follows it
+            draws[count] = draw;
+            count++;
+        }
+
+        targets[order[i]] = counter;
+        counter += draw.vertexCount;
+    }
+
+    // NOTE: Sorted draws can require more alignment vertex than unsorted ones,
+    // batch is drawn unsorted if they do not fit in the vertex buffer
+    if ((count == 0) || (counter > buffer->elementCount*4)) return;
+
+    // Copy batch vertex data to sort buffers
+    int vertexCount = RLGL.State.vertexCounter;
+
+    if (RLGL.State.sortBufferSize < buffer->elementCount*4)
+    {
+        RLGL.State.sortBufferSize = buffer->elementCount*4;
+        RLGL.State.sortVertices = (float *)RL_REALLOC(RLGL.State.sortVertices, RLGL.State.sortBufferSize*3*sizeof(float));
+        RLGL.State.sortTexcoords = (float *)RL_REALLOC(RLGL.State.sortTexcoords, RLGL.State.sortBufferSize*2*sizeof(float));
+        RLGL.State.sortColors = (unsigned char *)RL_REALLOC(RLGL.State.sortColors, RLGL.State.sortBufferSize*4*sizeof(unsigned char));
+    }
+
+    memcpy(RLGL.State.sortVertices, buffer->vertices, vertexCount*3*sizeof(float));
+    memcpy(RLGL.State.sortTexcoords, buffer->texcoords, vertexCount*2*sizeof(float));
+    memcpy(RLGL.State.sortColors, buffer->colors, vertexCount*4*sizeof(unsigned char));
+
+    // Move vertex data to sorted order
+    for (int i = 0; i < drawCount; i++)
+    {
+        int drawVertex = batch->draws[i].vertexCount;
+        if (drawVertex == 0) continue;
+
+        memcpy(buffer->vertices + targets[i]*3, RLGL.State.sortVertices + offsets[i]*3, drawVertex*3*sizeof(float));
+        memcpy(buffer->texcoords + targets[i]*2, RLGL.State.sortTexcoords + offsets[i]*2, drawVertex*2*sizeof(float));
+        memcpy(buffer->colors + targets[i]*4, RLGL.State.sortColors + offsets[i]*4, drawVertex*4*sizeof(unsigned char));
+    }
+
+    for (int i = 0; i < count; i++) batch->draws[i] = draws[i];
+    batch->drawCounter = count;
+    RLGL.State.vertexCounter = counter;
+}
+
+// Get vertex alignment required after a draw call
+// NOTE: Vertex count is aligned to a multiple of 4, that way, following QUADS drawing will keep
+// aligned with index processing, alignment vertex are not processed but considered as an offset
+static int rlGetDrawCallAlignment(rlDrawCall draw)
+{
+    int alignment = 0;
+
+    if (draw.mode == RL_LINES) alignment = ((draw.vertexCount < 4)? draw.vertexCount : draw.vertexCount%4);
+    else if (draw.mode == RL_TRIANGLES) alignment = ((draw.vertexCount < 4)? 1 : (4 - (draw.vertexCount%4)));
+
+    return alignment;
+}
+
 #if defined(RLGL_SHOW_GL_DETAILS_INFO)
 // Get compressed format official GL identifier name
 static char *rlGetCompressedFormatName(int format)
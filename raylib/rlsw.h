@@ -0,0 +1,2606 @@
+/**********************************************************************************************
+*
+*   rlsw v1.0 - Software rasterizer implementing the OpenGL 1.1 functionality used by rlgl
+*
+*   DESCRIPTION:
+*
+*   CPU implementation of the OpenGL 1.1 immediate mode, vertex arrays, matrix stacks,
+*   textures, blending and depth testing used by rlgl, so rlgl can draw into a memory
+*   framebuffer with no GPU or OpenGL driver available (headless servers, CI)
+*
+*   Vertex are transformed and clipped when submitted, resulting primitives (lines, triangles,
+*   clears) are set up and binned into screen tiles, tiles are rasterized on flush, that is,
+*   when pixels are read back (swReadPixels(), swGetColorBuffer()), textures are modified or
+*   swFinish() is called. Every tile draws its primitives in submission order, so blending
+*   result is the same one as drawing primitives one by one
+*
+*   FEATURES:
+*       - Lines, triangles and quads, immediate mode and vertex arrays (swDrawArrays(), swDrawElements())
+*       - Clipping against view frustum, backface culling, wire mode, thick lines
+*       - Perspective correct vertex colors and texture coordinates interpolation
+*       - Textures with nearest/linear filtering and repeat/mirror/clamp wrapping,
+*         8bit per channel and 16bit packed pixel formats
+*       - Blending (OpenGL 1.1 blend factors), depth test, scissor test
+*       - Tiles rasterized by multiple threads, SSE2 span filling for flat colored primitives
+*
+*   LIMITATIONS:
+*       - No mipmapping, lighting, fog, stencil or points
+*       - Texture matrix applied to (s, t) texture coordinates only
+*
+*   CONFIGURATION:
+*
+*   #define RLSW_IMPLEMENTATION
+*       Generates the implementation of the library into the included file.
+*       If not defined, the library is in header only mode and can be included in other headers
+*       or source files without problems. But only ONE file should hold the implementation.
+*
+*   #define RLSW_GL_NAMES
+*       Map OpenGL 1.1 function and constant names to rlsw ones, so OpenGL 1.1 code
+*       (like rlgl OpenGL 1.1 backend) can run unmodified on rlsw
+*
+*   rlsw capabilities could be customized just defining some internal
+*   values before library inclusion (default values listed):
+*
+*   #define RLSW_TILE_SIZE                  64      // Screen tiles size in pixels, primitives are binned by tile
+*   #define RLSW_MAX_THREADS                 4      // Threads rasterizing tiles (including calling thread), 1 disables workers
+*   #define RLSW_MAX_PRIMITIVES          65536      // Primitives accumulated before tiles are rasterized
+*   #define RLSW_MAX_MATRIX_STACK_SIZE      32      // Maximum size of every matrix stack
+*
+*   DEPENDENCIES:
+*
+*      - POSIX threads (Win32 threads on Windows)
+*
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2022 Ramon Santamaria (@raysan5)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+#ifndef RLSW_H
+#define RLSW_H
+
+#define RLSW_VERSION    "1.0"
+
+#ifndef SWAPI
+    #define SWAPI       // Functions defined as 'extern' by default (implicit specifiers)
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#ifndef RLSW_TILE_SIZE
+    #define RLSW_TILE_SIZE                  64      // Screen tiles size in pixels
+#endif
+#ifndef RLSW_MAX_THREADS
+    #define RLSW_MAX_THREADS                 4      // Threads rasterizing tiles, including calling thread
+#endif
+#ifndef RLSW_MAX_PRIMITIVES
+    #define RLSW_MAX_PRIMITIVES          65536      // Primitives accumulated before tiles are rasterized
+#endif
+#ifndef RLSW_MAX_MATRIX_STACK_SIZE
+    #define RLSW_MAX_MATRIX_STACK_SIZE      32      // Maximum size of every matrix stack
+#endif
+
+// NOTE: Constant values match OpenGL ones
+
+// Boolean values
+#define SW_FALSE                        0
+#define SW_TRUE                         1
+
+// Primitives
+#define SW_LINES                        0x0001
+#define SW_TRIANGLES                    0x0004
+#define SW_QUADS                        0x0007
+
+// Capabilities (swEnable()/swDisable())
+#define SW_LINE_SMOOTH                  0x0B20      // Accepted, lines are not antialiased
+#define SW_CULL_FACE                    0x0B44
+#define SW_DEPTH_TEST                   0x0B71
+#define SW_BLEND                        0x0BE2
+#define SW_SCISSOR_TEST                 0x0C11
+#define SW_TEXTURE_2D                   0x0DE1
+
+// Client states (vertex arrays)
+#define SW_VERTEX_ARRAY                 0x8074
+#define SW_NORMAL_ARRAY                 0x8075
+#define SW_COLOR_ARRAY                  0x8076
+#define SW_TEXTURE_COORD_ARRAY          0x8078
+
+// Matrix modes
+#define SW_MODELVIEW                    0x1700
+#define SW_PROJECTION                   0x1701
+#define SW_TEXTURE                      0x1702
+
+// Queried values (swGetFloatv())
+#define SW_LINE_WIDTH                   0x0B21
+#define SW_MODELVIEW_MATRIX             0x0BA6
+#define SW_PROJECTION_MATRIX            0x0BA7
+#define SW_TEXTURE_MATRIX               0x0BA8
+
+// Clear buffer bits
+#define SW_DEPTH_BUFFER_BIT             0x00000100
+#define SW_COLOR_BUFFER_BIT             0x00004000
+
+// Blend factors
+#define SW_ZERO                         0
+#define SW_ONE                          1
+#define SW_SRC_COLOR                    0x0300
+#define SW_ONE_MINUS_SRC_COLOR          0x0301
+#define SW_SRC_ALPHA                    0x0302
+#define SW_ONE_MINUS_SRC_ALPHA          0x0303
+#define SW_DST_ALPHA                    0x0304
+#define SW_ONE_MINUS_DST_ALPHA          0x0305
+#define SW_DST_COLOR                    0x0306
+#define SW_ONE_MINUS_DST_COLOR          0x0307
+#define SW_SRC_ALPHA_SATURATE           0x0308
+
+// Depth functions
+#define SW_NEVER                        0x0200
+#define SW_LESS                         0x0201
+#define SW_EQUAL                        0x0202
+#define SW_LEQUAL                       0x0203
+#define SW_GREATER                      0x0204
+#define SW_NOTEQUAL                     0x0205
+#define SW_GEQUAL                       0x0206
+#define SW_ALWAYS                       0x0207
+
+// Faces and polygon modes
+#define SW_FRONT                        0x0404
+#define SW_BACK                         0x0405
+#define SW_FRONT_AND_BACK               0x0408
+#define SW_CW                           0x0900
+#define SW_CCW                          0x0901
+#define SW_POINT                        0x1B00
+#define SW_LINE                         0x1B01
+#define SW_FILL                         0x1B02
+
+// Data types
+#define SW_UNSIGNED_BYTE                0x1401
+#define SW_UNSIGNED_SHORT               0x1403
+#define SW_UNSIGNED_INT                 0x1405
+#define SW_FLOAT                        0x1406
+#define SW_UNSIGNED_SHORT_4_4_4_4       0x8033
+#define SW_UNSIGNED_SHORT_5_5_5_1       0x8034
+#define SW_UNSIGNED_SHORT_5_6_5         0x8363
+
+// Pixel formats
+#define SW_RGB                          0x1907
+#define SW_RGBA                         0x1908
+#define SW_LUMINANCE                    0x1909
+#define SW_LUMINANCE_ALPHA              0x190A
+#define SW_RGBA8                        0x8058
+
+// Texture parameters
+#define SW_TEXTURE_MAG_FILTER           0x2800
+#define SW_TEXTURE_MIN_FILTER           0x2801
+#define SW_TEXTURE_WRAP_S               0x2802
+#define SW_TEXTURE_WRAP_T               0x2803
+#define SW_NEAREST                      0x2600
+#define SW_LINEAR                       0x2601
+#define SW_NEAREST_MIPMAP_NEAREST       0x2700
+#define SW_LINEAR_MIPMAP_NEAREST        0x2701
+#define SW_NEAREST_MIPMAP_LINEAR        0x2702
+#define SW_LINEAR_MIPMAP_LINEAR         0x2703
+#define SW_CLAMP                        0x2900
+#define SW_REPEAT                       0x2901
+#define SW_CLAMP_TO_EDGE                0x812F
+#define SW_MIRRORED_REPEAT              0x8370
+#define SW_MIRROR_CLAMP_EXT             0x8742
+
+// Pixel storage
+#define SW_UNPACK_ALIGNMENT             0x0CF5
+#define SW_PACK_ALIGNMENT               0x0D05
+
+// Strings (swGetString())
+#define SW_VENDOR                       0x1F00
+#define SW_RENDERER                     0x1F01
+#define SW_VERSION                      0x1F02
+#define SW_EXTENSIONS                   0x1F03
+#define SW_SHADING_LANGUAGE_VERSION     0x8B8C
+
+// Hints and shading (accepted, no effect)
+#define SW_PERSPECTIVE_CORRECTION_HINT  0x0C50
+#define SW_DONT_CARE                    0x1100
+#define SW_FASTEST                      0x1101
+#define SW_NICEST                       0x1102
+#define SW_FLAT                         0x1D00
+#define SW_SMOOTH                       0x1D01
+
+// Errors (swGetError())
+#define SW_NO_ERROR                     0
+#define SW_INVALID_ENUM                 0x0500
+#define SW_INVALID_VALUE                0x0501
+#define SW_INVALID_OPERATION            0x0502
+#define SW_STACK_OVERFLOW               0x0503
+#define SW_STACK_UNDERFLOW              0x0504
+#define SW_OUT_OF_MEMORY                0x0505
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+// Context management
+SWAPI int swInit(int width, int height);                    // Initialize rasterizer with a framebuffer of given size, returns 0 on failure
+SWAPI void swClose(void);                                   // Close rasterizer, worker threads stopped and memory freed
+SWAPI int swResize(int width, int height);                  // Resize framebuffer (content discarded), returns 0 on failure
+SWAPI unsigned char *swGetColorBuffer(int *width, int *height); // Get framebuffer RGBA pixels (bottom row first), pending primitives drawn
+SWAPI void swFinish(void);                                  // Draw all pending primitives
+SWAPI void swFlush(void);                                   // Draw all pending primitives
+SWAPI int swGetError(void);                                 // Get and reset last error
+
+// State management
+SWAPI void swEnable(int cap);                               // Enable capability
+SWAPI void swDisable(int cap);                              // Disable capability
+SWAPI void swViewport(int x, int y, int width, int height); // Set viewport (normalized device coordinates to window coordinates)
+SWAPI void swScissor(int x, int y, int width, int height);  // Set scissor rectangle
+SWAPI void swClearColor(float r, float g, float b, float a); // Set clear color
+SWAPI void swClearDepth(double depth);                      // Set clear depth
+SWAPI void swClear(unsigned int mask);                      // Clear color and/or depth buffers
+SWAPI void swBlendFunc(int sfactor, int dfactor);           // Set blending factors
+SWAPI void swDepthFunc(int func);                           // Set depth test function
+SWAPI void swDepthMask(unsigned char flag);                 // Enable/disable depth writes
+SWAPI void swCullFace(int mode);                            // Set faces culled
+SWAPI void swFrontFace(int mode);                           // Set front faces winding
+SWAPI void swPolygonMode(int face, int mode);               // Set polygons fill or wire mode
+SWAPI void swLineWidth(float width);                        // Set lines width
+SWAPI void swHint(int target, int mode);                    // Set hint (no effect)
+SWAPI void swShadeModel(int mode);                          // Set shading model (no effect, always smooth)
+SWAPI void swPixelStorei(int pname, int param);             // Set pixel data rows alignment
+SWAPI void swGetFloatv(int pname, float *params);           // Get line width or matrices
+SWAPI const unsigned char *swGetString(int name);           // Get vendor, renderer and version strings
+
+// Matrix operations
+SWAPI void swMatrixMode(int mode);                          // Choose current matrix stack
+SWAPI void swPushMatrix(void);                              // Push current matrix to stack
+SWAPI void swPopMatrix(void);                               // Pop current matrix from stack
+SWAPI void swLoadIdentity(void);                            // Reset current matrix to identity
+SWAPI void swTranslatef(float x, float y, float z);         // Multiply current matrix by a translation
+SWAPI void swRotatef(float angle, float x, float y, float z); // Multiply current matrix by a rotation (angle in degrees)
+SWAPI void swScalef(float x, float y, float z);             // Multiply current matrix by a scaling
+SWAPI void swMultMatrixf(const float *matf);                // Multiply current matrix by another one (column-major)
+SWAPI void swOrtho(double left, double right, double bottom, double top, double znear, double zfar);
+SWAPI void swFrustum(double left, double right, double bottom, double top, double znear, double zfar);
+
+// Immediate mode vertex submission
+SWAPI void swBegin(int mode);                               // Begin primitives (SW_LINES, SW_TRIANGLES, SW_QUADS)
+SWAPI void swEnd(void);                                     // End primitives
+SWAPI void swVertex2i(int x, int y);
+SWAPI void swVertex2f(float x, float y);
+SWAPI void swVertex3f(float x, float y, float z);
+SWAPI void swTexCoord2f(float x, float y);
+SWAPI void swNormal3f(float x, float y, float z);           // Accepted, no lighting
+SWAPI void swColor3f(float r, float g, float b);
+SWAPI void swColor4f(float r, float g, float b, float a);
+SWAPI void swColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+
+// Vertex arrays
+SWAPI void swEnableClientState(int array);
+SWAPI void swDisableClientState(int array);
+SWAPI void swVertexPointer(int size, int type, int stride, const void *pointer);
+SWAPI void swTexCoordPointer(int size, int type, int stride, const void *pointer);
+SWAPI void swNormalPointer(int type, int stride, const void *pointer);
+SWAPI void swColorPointer(int size, int type, int stride, const void *pointer);
+SWAPI void swDrawArrays(int mode, int first, int count);
+SWAPI void swDrawElements(int mode, int count, int type, const void *indices);
+
+// Textures
+SWAPI void swGenTextures(int count, unsigned int *textures);
+SWAPI void swDeleteTextures(int count, const unsigned int *textures);
+SWAPI void swBindTexture(int target, unsigned int texture);
+SWAPI void swTexImage2D(int target, int level, int internalFormat, int width, int height, int border, int format, int type, const void *pixels);
+SWAPI void swTexSubImage2D(int target, int level, int offsetX, int offsetY, int width, int height, int format, int type, const void *pixels);
+SWAPI void swTexParameteri(int target, int pname, int param);
+SWAPI void swGetTexImage(int target, int level, int format, int type, void *pixels);
+
+// Framebuffer read
+SWAPI void swReadPixels(int x, int y, int width, int height, int format, int type, void *pixels);
+
+#if defined(__cplusplus)
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// OpenGL 1.1 names mapping
+//----------------------------------------------------------------------------------
+#if defined(RLSW_GL_NAMES)
+    #define glEnable                    swEnable
+    #define glDisable                   swDisable
+    #define glViewport                  swViewport
+    #define glScissor                   swScissor
+    #define glClearColor                swClearColor
+    #define glClearDepth                swClearDepth
+    #define glClear                     swClear
+    #define glBlendFunc                 swBlendFunc
+    #define glDepthFunc                 swDepthFunc
+    #define glDepthMask                 swDepthMask
+    #define glCullFace                  swCullFace
+    #define glFrontFace                 swFrontFace
+    #define glPolygonMode               swPolygonMode
+    #define glLineWidth                 swLineWidth
+    #define glHint                      swHint
+    #define glShadeModel                swShadeModel
+    #define glPixelStorei               swPixelStorei
+    #define glGetFloatv                 swGetFloatv
+    #define glGetString                 swGetString
+    #define glGetError                  swGetError
+    #define glFinish                    swFinish
+    #define glFlush                     swFlush
+    #define glMatrixMode                swMatrixMode
+    #define glPushMatrix                swPushMatrix
+    #define glPopMatrix                 swPopMatrix
+    #define glLoadIdentity              swLoadIdentity
+    #define glTranslatef                swTranslatef
+    #define glRotatef                   swRotatef
+    #define glScalef                    swScalef
+    #define glMultMatrixf               swMultMatrixf
+    #define glOrtho                     swOrtho
+    #define glFrustum                   swFrustum
+    #define glBegin                     swBegin
+    #define glEnd                       swEnd
+    #define glVertex2i                  swVertex2i
+    #define glVertex2f                  swVertex2f
+    #define glVertex3f                  swVertex3f
+    #define glTexCoord2f                swTexCoord2f
+    #define glNormal3f                  swNormal3f
+    #define glColor3f                   swColor3f
+    #define glColor4f                   swColor4f
+    #define glColor4ub                  swColor4ub
+    #define glEnableClientState         swEnableClientState
+    #define glDisableClientState        swDisableClientState
+    #define glVertexPointer             swVertexPointer
+    #define glTexCoordPointer           swTexCoordPointer
+    #define glNormalPointer             swNormalPointer
+    #define glColorPointer              swColorPointer
+    #define glDrawArrays                swDrawArrays
+    #define glDrawElements              swDrawElements
+    #define glGenTextures               swGenTextures
+    #define glDeleteTextures            swDeleteTextures
+    #define glBindTexture               swBindTexture
+    #define glTexImage2D                swTexImage2D
+    #define glTexSubImage2D             swTexSubImage2D
+    #define glTexParameteri             swTexParameteri
+    #define glGetTexImage               swGetTexImage
+    #define glReadPixels                swReadPixels
+
+    #define GL_FALSE                    SW_FALSE
+    #define GL_TRUE                     SW_TRUE
+    #define GL_LINES                    SW_LINES
+    #define GL_TRIANGLES                SW_TRIANGLES
+    #define GL_QUADS                    SW_QUADS
+    #define GL_LINE_SMOOTH              SW_LINE_SMOOTH
+    #define GL_CULL_FACE                SW_CULL_FACE
+    #define GL_DEPTH_TEST               SW_DEPTH_TEST
+    #define GL_BLEND                    SW_BLEND
+    #define GL_SCISSOR_TEST             SW_SCISSOR_TEST
+    #define GL_TEXTURE_2D               SW_TEXTURE_2D
+    #define GL_VERTEX_ARRAY             SW_VERTEX_ARRAY
+    #define GL_NORMAL_ARRAY             SW_NORMAL_ARRAY
+    #define GL_COLOR_ARRAY              SW_COLOR_ARRAY
+    #define GL_TEXTURE_COORD_ARRAY      SW_TEXTURE_COORD_ARRAY
+    #define GL_MODELVIEW                SW_MODELVIEW
+    #define GL_PROJECTION               SW_PROJECTION
+    #define GL_TEXTURE                  SW_TEXTURE
+    #define GL_LINE_WIDTH               SW_LINE_WIDTH
+    #define GL_MODELVIEW_MATRIX         SW_MODELVIEW_MATRIX
+    #define GL_PROJECTION_MATRIX        SW_PROJECTION_MATRIX
+    #define GL_TEXTURE_MATRIX           SW_TEXTURE_MATRIX
+    #define GL_DEPTH_BUFFER_BIT         SW_DEPTH_BUFFER_BIT
+    #define GL_COLOR_BUFFER_BIT         SW_COLOR_BUFFER_BIT
+    #define GL_ZERO                     SW_ZERO
+    #define GL_ONE                      SW_ONE
+    #define GL_SRC_COLOR                SW_SRC_COLOR
+    #define GL_ONE_MINUS_SRC_COLOR      SW_ONE_MINUS_SRC_COLOR
+    #define GL_SRC_ALPHA                SW_SRC_ALPHA
+    #define GL_ONE_MINUS_SRC_ALPHA      SW_ONE_MINUS_SRC_ALPHA
+    #define GL_DST_ALPHA                SW_DST_ALPHA
+    #define GL_ONE_MINUS_DST_ALPHA      SW_ONE_MINUS_DST_ALPHA
+    #define GL_DST_COLOR                SW_DST_COLOR
+    #define GL_ONE_MINUS_DST_COLOR      SW_ONE_MINUS_DST_COLOR
+    #define GL_SRC_ALPHA_SATURATE       SW_SRC_ALPHA_SATURATE
+    #define GL_NEVER                    SW_NEVER
+    #define GL_LESS                     SW_LESS
+    #define GL_EQUAL                    SW_EQUAL
+    #define GL_LEQUAL                   SW_LEQUAL
+    #define GL_GREATER                  SW_GREATER
+    #define GL_NOTEQUAL                 SW_NOTEQUAL
+    #define GL_GEQUAL                   SW_GEQUAL
+    #define GL_ALWAYS                   SW_ALWAYS
+    #define GL_FRONT                    SW_FRONT
+    #define GL_BACK                     SW_BACK
+    #define GL_FRONT_AND_BACK           SW_FRONT_AND_BACK
+    #define GL_CW                       SW_CW
+    #define GL_CCW                      SW_CCW
+    #define GL_POINT                    SW_POINT
+    #define GL_LINE                     SW_LINE
+    #define GL_FILL                     SW_FILL
+    #define GL_UNSIGNED_BYTE            SW_UNSIGNED_BYTE
+    #define GL_UNSIGNED_SHORT           SW_UNSIGNED_SHORT
+    #define GL_UNSIGNED_INT             SW_UNSIGNED_INT
+    #define GL_FLOAT                    SW_FLOAT
+    #define GL_UNSIGNED_SHORT_4_4_4_4   SW_UNSIGNED_SHORT_4_4_4_4
+    #define GL_UNSIGNED_SHORT_5_5_5_1   SW_UNSIGNED_SHORT_5_5_5_1
+    #define GL_UNSIGNED_SHORT_5_6_5     SW_UNSIGNED_SHORT_5_6_5
+    #define GL_RGB                      SW_RGB
+    #define GL_RGBA                     SW_RGBA
+    #define GL_LUMINANCE                SW_LUMINANCE
+    #define GL_LUMINANCE_ALPHA          SW_LUMINANCE_ALPHA
+    #define GL_RGBA8                    SW_RGBA8
+    #define GL_TEXTURE_MAG_FILTER       SW_TEXTURE_MAG_FILTER
+    #define GL_TEXTURE_MIN_FILTER       SW_TEXTURE_MIN_FILTER
+    #define GL_TEXTURE_WRAP_S           SW_TEXTURE_WRAP_S
+    #define GL_TEXTURE_WRAP_T           SW_TEXTURE_WRAP_T
+    #define GL_NEAREST                  SW_NEAREST
+    #define GL_LINEAR                   SW_LINEAR
+    #define GL_CLAMP                    SW_CLAMP
+    #define GL_REPEAT                   SW_REPEAT
+    #define GL_CLAMP_TO_EDGE            SW_CLAMP_TO_EDGE
+    #define GL_MIRRORED_REPEAT          SW_MIRRORED_REPEAT
+    #define GL_UNPACK_ALIGNMENT         SW_UNPACK_ALIGNMENT
+    #define GL_PACK_ALIGNMENT           SW_PACK_ALIGNMENT
+    #define GL_PERSPECTIVE_CORRECTION_HINT SW_PERSPECTIVE_CORRECTION_HINT
+    #define GL_NICEST                   SW_NICEST
+    #define GL_FLAT                     SW_FLAT
+    #define GL_SMOOTH                   SW_SMOOTH
+    #define GL_VENDOR                   SW_VENDOR
+    #define GL_RENDERER                 SW_RENDERER
+    #define GL_VERSION                  SW_VERSION
+    #define GL_EXTENSIONS               SW_EXTENSIONS
+    #define GL_SHADING_LANGUAGE_VERSION SW_SHADING_LANGUAGE_VERSION
+    #define GL_NO_ERROR                 SW_NO_ERROR
+#endif  // RLSW_GL_NAMES
+
+#endif  // RLSW_H
+
+/***********************************************************************************
+*
+*   RLSW IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(RLSW_IMPLEMENTATION)
+
+#include <stdlib.h>                 // Required for: malloc(), calloc(), realloc(), free()
+#include <string.h>                 // Required for: memcpy(), memset()
+#include <math.h>                   // Required for: sqrtf(), sinf(), cosf(), floorf(), ceilf(), fabsf()
+
+#if (defined(__STDC__) && __STDC_VERSION__ >= 199901L) || (defined(_MSC_VER) && _MSC_VER >= 1800)
+    #include <stdbool.h>
+#elif !defined(__cplusplus) && !defined(bool)
+    typedef enum bool { false = 0, true = !false } bool;
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define RLSW_SSE2
+    #include <emmintrin.h>          // Required for: SSE2 span filling
+#endif
+
+#if defined(_WIN32)
+    #if !defined(_WINDOWS_)
+        // NOTE: Required Win32 functions are declared here instead of including windows.h,
+        // its names conflict with raylib ones (Rectangle, CloseWindow, ShowCursor...)
+        __declspec(dllimport) void *__stdcall CreateThread(void *attributes, size_t stackSize, unsigned long (__stdcall *start)(void *), void *param, unsigned long flags, unsigned long *threadId);
+        __declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void *handle, unsigned long milliseconds);
+        __declspec(dllimport) int __stdcall CloseHandle(void *handle);
+        __declspec(dllimport) void __stdcall InitializeSRWLock(void *lock);
+        __declspec(dllimport) void __stdcall AcquireSRWLockExclusive(void *lock);
+        __declspec(dllimport) void __stdcall ReleaseSRWLockExclusive(void *lock);
+        __declspec(dllimport) void __stdcall InitializeConditionVariable(void *cond);
+        __declspec(dllimport) int __stdcall SleepConditionVariableSRW(void *cond, void *lock, unsigned long milliseconds, unsigned long flags);
+        __declspec(dllimport) void __stdcall WakeAllConditionVariable(void *cond);
+    #endif
+#else
+    #include <pthread.h>            // Required for: pthread_create(), pthread_join(), pthread_mutex_*, pthread_cond_*
+#endif
+
+#ifndef SW_MALLOC
+    #define SW_MALLOC(sz)       malloc(sz)
+#endif
+#ifndef SW_CALLOC
+    #define SW_CALLOC(n,sz)     calloc(n,sz)
+#endif
+#ifndef SW_REALLOC
+    #define SW_REALLOC(ptr,sz)  realloc(ptr,sz)
+#endif
+#ifndef SW_FREE
+    #define SW_FREE(ptr)        free(ptr)
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SW_MAX_CLIP_VERTICES        16      // Maximum vertex of a polygon clipped by the 6 frustum planes
+
+#define SW_PRIMITIVE_CLEAR           0      // Clear color and/or depth inside bounds
+#define SW_PRIMITIVE_LINE            1      // One pixel wide line
+#define SW_PRIMITIVE_TRIANGLE        2      // Filled triangle
+
+#define SW_TRIANGLE_AFFINE        0x01      // All vertex share w, attributes interpolated linearly
+#define SW_TRIANGLE_FLAT          0x02      // All vertex share color
+#define SW_TRIANGLE_LINEAR        0x04      // Texture sampled with linear filter
+
+// Triangle interpolated attributes
+#define SW_ATTRIB_Z                  0
+#define SW_ATTRIB_INVW               1
+#define SW_ATTRIB_U                  2
+#define SW_ATTRIB_V                  3
+#define SW_ATTRIB_R                  4      // Followed by G, B, A
+#define SW_ATTRIB_COUNT              8
+
+#define SW_MIN(a, b)                (((a) < (b))? (a) : (b))
+#define SW_MAX(a, b)                (((a) > (b))? (a) : (b))
+
+// NOTE: Integer floor/ceil, floorf()/ceilf() are library calls without SSE4.1, values must fit an int
+#define SW_FLOOR(x)                 ((int)(x) - ((x) < (float)(int)(x)))
+#define SW_CEIL(x)                  ((int)(x) + ((x) > (float)(int)(x)))
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+#if defined(_WIN32)
+typedef void *swThread;
+typedef struct { void *ptr; } swMutex;      // SRWLOCK
+typedef struct { void *ptr; } swCond;       // CONDITION_VARIABLE
+#else
+typedef pthread_t swThread;
+typedef pthread_mutex_t swMutex;
+typedef pthread_cond_t swCond;
+#endif
+
+// Texture data, always stored as RGBA 8bit per channel
+typedef struct swTexture {
+    unsigned char *pixels;          // Texture pixels, first row is the one at t = 0
+    int width;                      // Texture width
+    int height;                     // Texture height
+    int minFilter;                  // Minification filter
+    int magFilter;                  // Magnification filter
+    int wrapS;                      // Horizontal wrap mode
+    int wrapT;                      // Vertical wrap mode
+} swTexture;
+
+// Vertex in clip space
+typedef struct swVertex {
+    float position[4];              // Clip space position (x, y, z, w)
+    float texcoord[2];              // Texture coordinates
+    float color[4];                 // Color (normalized)
+} swVertex;
+
+// Vertex in window space
+typedef struct swScreenVertex {
+    float x, y;                     // Window coordinates (origin at bottom-left)
+    float z;                        // Depth [0..1]
+    float invW;                     // Clip space 1/w
+    float texcoord[2];              // Texture coordinates
+    float color[4];                 // Color (normalized)
+} swScreenVertex;
+
+// Render state used by primitives, captured on submission
+typedef struct swRenderState {
+    swTexture *texture;             // Texture sampled, NULL if texturing disabled
+    bool blend;                     // Blending enabled
+    int srcFactor;                  // Blending source factor
+    int dstFactor;                  // Blending destination factor
+    bool depthTest;                 // Depth test enabled
+    bool depthMask;                 // Depth write enabled
+    int depthFunc;                  // Depth test function
+} swRenderState;
+
+// Triangle setup: edge functions and attributes planes
+typedef struct swTriangleSetup {
+    float edges[3][3];              // Edge functions (A, B, C), pixel inside if A*x + B*y + C >= 0 for all edges
+    int topLeft;                    // Edges including pixels centered on them (top-left rule), bit per edge
+    int flags;                      // SW_TRIANGLE_* flags
+    float x0, y0;                   // Planes reference point
+    float planes[SW_ATTRIB_COUNT][3];   // Attributes value at reference point and x/y gradients
+    float color[4];                 // Flat color (SW_TRIANGLE_FLAT)
+    unsigned int packedColor;       // Flat color packed, used by flat spans
+} swTriangleSetup;
+
+// Line setup: end points, attributes multiplied by 1/w
+typedef struct swLineSetup {
+    swScreenVertex v[2];
+} swLineSetup;
+
+// Clear setup
+typedef struct swClearSetup {
+    unsigned int color;             // Packed RGBA color
+    float depth;                    // Depth value
+    unsigned int mask;              // Buffers cleared
+} swClearSetup;
+
+// Primitive waiting for rasterization
+typedef struct swPrimitive {
+    int type;                       // SW_PRIMITIVE_*
+    int state;                      // Render state index
+    int bounds[4];                  // Pixels covered (inclusive): minX, minY, maxX, maxY
+    union {
+        swTriangleSetup triangle;
+        swLineSetup line;
+        swClearSetup clear;
+    } setup;
+} swPrimitive;
+
+// Primitives list of a screen tile, in submission order
+typedef struct swTileBin {
+    int *items;                     // Primitives indices
+    int count;                      // Primitives binned
+    int capacity;                   // Items capacity
+} swTileBin;
+
+// Vertex array pointer
+typedef struct swArray {
+    bool enabled;
+    int size;
+    int type;
+    int stride;
+    const unsigned char *pointer;
+} swArray;
+
+// Rasterizer global context
+typedef struct swContext {
+    // Framebuffer
+    int width;                      // Framebuffer width
+    int height;                     // Framebuffer height
+    unsigned int *colorBuffer;      // Color buffer, RGBA bytes per pixel, bottom row first
+    float *depthBuffer;             // Depth buffer
+
+    // Tiles and primitives
+    int tilesX;                     // Tiles per row
+    int tilesY;                     // Tiles per column
+    swTileBin *bins;                // Primitives binned by tile
+    swPrimitive *primitives;        // Primitives waiting for rasterization
+    int primitiveCount;
+    int primitiveCapacity;
+    swRenderState *states;          // Render states used by primitives
+    int stateCount;
+    int stateCapacity;
+    bool stateDirty;                // Current render state changed since last captured
+
+    // Worker threads
+    swThread workers[RLSW_MAX_THREADS];
+    int workerCount;
+    swMutex lock;                   // Protects fields below
+    swCond startCond;               // Signaled when a job starts or on quit
+    swCond doneCond;                // Signaled when last worker ends its job
+    unsigned int jobId;             // Current job id, incremented on every flush
+    int jobsRunning;                // Workers still rasterizing current job
+    int nextTile;                   // Next tile to rasterize
+    bool quit;                      // Workers must exit
+
+    // Render state
+    int viewport[4];
+    int scissor[4];
+    int clipBounds[4];              // Viewport, scissor and framebuffer intersection (inclusive bounds)
+    bool scissorTest;
+    bool blend;
+    int srcFactor;
+    int dstFactor;
+    bool depthTest;
+    bool depthMask;
+    int depthFunc;
+    bool cullFace;
+    int cullMode;
+    int frontFace;
+    int polygonMode;
+    float lineWidth;
+    bool texture2D;
+    unsigned int boundTexture;
+    float clearColor[4];
+    float clearDepth;
+    int unpackAlignment;
+    int packAlignment;
+    int error;
+
+    // Matrices (column-major)
+    float stacks[3][RLSW_MAX_MATRIX_STACK_SIZE][16];    // Modelview, projection and texture stacks
+    int stackDepth[3];
+    int matrixMode;                 // Current stack index
+    float mvp[16];                  // Projection*modelview
+    bool mvpDirty;
+    bool textureMatrixIdentity;
+
+    // Immediate mode
+    int primitiveMode;              // Current swBegin() mode, 0 outside swBegin()/swEnd()
+    swVertex vertices[4];           // Primitive vertex being assembled
+    int vertexCount;
+    float texcoord[2];              // Current texture coordinates
+    float color[4];                 // Current color
+
+    // Vertex arrays
+    swArray vertexArray;
+    swArray texcoordArray;
+    swArray colorArray;
+
+    // Textures
+    swTexture **textures;           // Textures by id (id 0 unused)
+    int textureCapacity;
+    unsigned int textureCounter;    // Last generated id
+} swContext;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static swContext SW = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Declaration
+//----------------------------------------------------------------------------------
+static void swUpdateClipBounds(void);                                       // Update primitives clip bounds after viewport/scissor changes
+static swPrimitive *swPushPrimitive(int type, const int *bounds);           // Add primitive and bin it into tiles it covers
+static void swSubmitVertex(float x, float y, float z, const float *texcoord, const float *color);  // Transform vertex and assemble primitives
+static void swSubmitPolygon(swVertex *polygon, int count);                  // Clip, cull and set up a triangle or quad
+static void swSubmitLine(const swVertex *a, const swVertex *b);             // Clip and set up a line
+static void swSetupTriangle(const swScreenVertex *a, const swScreenVertex *b, const swScreenVertex *c);
+static void swSetupLine(const swScreenVertex *a, const swScreenVertex *b);
+static void swRasterizeTiles(void);                                         // Rasterize tiles until none left (called by every thread)
+static swTexture *swGetBoundTexture(void);                                  // Get bound texture, NULL if none
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Definition - Threads
+//----------------------------------------------------------------------------------
+#if defined(_WIN32)
+static void swMutexInit(swMutex *mutex) { InitializeSRWLock(mutex); }
+static void swMutexDestroy(swMutex *mutex) { (void)mutex; }
+static void swMutexLock(swMutex *mutex) { AcquireSRWLockExclusive(mutex); }
+static void swMutexUnlock(swMutex *mutex) { ReleaseSRWLockExclusive(mutex); }
+static void swCondInit(swCond *cond) { InitializeConditionVariable(cond); }
+static void swCondDestroy(swCond *cond) { (void)cond; }
+static void swCondWait(swCond *cond, swMutex *mutex) { SleepConditionVariableSRW(cond, mutex, 0xFFFFFFFF, 0); }
+static void swCondBroadcast(swCond *cond) { WakeAllConditionVariable(cond); }
+#else
+static void swMutexInit(swMutex *mutex) { pthread_mutex_init(mutex, NULL); }
+static void swMutexDestroy(swMutex *mutex) { pthread_mutex_destroy(mutex); }
+static void swMutexLock(swMutex *mutex) { pthread_mutex_lock(mutex); }
+static void swMutexUnlock(swMutex *mutex) { pthread_mutex_unlock(mutex); }
+static void swCondInit(swCond *cond) { pthread_cond_init(cond, NULL); }
+static void swCondDestroy(swCond *cond) { pthread_cond_destroy(cond); }
+static void swCondWait(swCond *cond, swMutex *mutex) { pthread_cond_wait(cond, mutex); }
+static void swCondBroadcast(swCond *cond) { pthread_cond_broadcast(cond); }
+#endif
+
+// Worker thread, rasterizes tiles every time a job starts
+#if defined(_WIN32)
+static unsigned long __stdcall swWorkerThread(void *arg)
+#else
+static void *swWorkerThread(void *arg)
+#endif
+{
+    unsigned int jobId = 0;
+    (void)arg;
+
+    while (true)
+    {
+        swMutexLock(&SW.lock);
+        while (!SW.quit && (SW.jobId == jobId)) swCondWait(&SW.startCond, &SW.lock);
+
+        if (SW.quit)
+        {
+            swMutexUnlock(&SW.lock);
+            break;
+        }
+
+        jobId = SW.jobId;
+        swMutexUnlock(&SW.lock);
+
+        swRasterizeTiles();
+
+        swMutexLock(&SW.lock);
+        SW.jobsRunning--;
+        if (SW.jobsRunning == 0) swCondBroadcast(&SW.doneCond);
+        swMutexUnlock(&SW.lock);
+    }
+
+    return 0;
+}
+
+static bool swThreadCreate(swThread *thread)
+{
+#if defined(_WIN32)
+    *thread = CreateThread(NULL, 0, swWorkerThread, NULL, 0, NULL);
+    return (*thread != NULL);
+#else
+    return (pthread_create(thread, NULL, swWorkerThread, NULL) == 0);
+#endif
+}
+
+static void swThreadJoin(swThread thread)
+{
+#if defined(_WIN32)
+    WaitForSingleObject(thread, 0xFFFFFFFF);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Definition - Math
+//----------------------------------------------------------------------------------
+static void swMatrixIdentity(float *mat)
+{
+    memset(mat, 0, 16*sizeof(float));
+    mat[0] = mat[5] = mat[10] = mat[15] = 1.0f;
+}
+
+// Multiply column-major matrices: result = left*right
+static void swMatrixMultiply(float *result, const float *left, const float *right)
+{
+    float temp[16];
+
+    for (int col = 0; col < 4; col++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            temp[col*4 + row] = left[row]*right[col*4] + left[4 + row]*right[col*4 + 1] +
+                                left[8 + row]*right[col*4 + 2] + left[12 + row]*right[col*4 + 3];
+        }
+    }
+
+    memcpy(result, temp, sizeof(temp));
+}
+
+// Multiply current matrix by another one
+static void swMultiplyCurrent(const float *mat)
+{
+    float *current = SW.stacks[SW.matrixMode][SW.stackDepth[SW.matrixMode]];
+    swMatrixMultiply(current, current, mat);
+
+    if (SW.matrixMode == 2) SW.textureMatrixIdentity = false;
+    else SW.mvpDirty = true;
+}
+
+static unsigned int swPackColor(const float *color)
+{
+    unsigned char bytes[4];
+    unsigned int packed = 0;
+
+    for (int i = 0; i < 4; i++)
+    {
+        float value = (color[i] < 0.0f)? 0.0f : ((color[i] > 1.0f)? 1.0f : color[i]);
+        bytes[i] = (unsigned char)(value*255.0f + 0.5f);
+    }
+
+    memcpy(&packed, bytes, 4);
+    return packed;
+}
+
+static void swSetError(int error)
+{
+    if (SW.error == SW_NO_ERROR) SW.error = error;
+}
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Definition - Pixels conversion
+//----------------------------------------------------------------------------------
+
+// Get bytes per pixel of an external pixel format, 0 if not supported
+static int swGetPixelSize(int format, int type)
+{
+    if (type == SW_UNSIGNED_BYTE)
+    {
+        switch (format)
+        {
+            case SW_LUMINANCE: return 1;
+            case SW_LUMINANCE_ALPHA: return 2;
+            case SW_RGB: return 3;
+            case SW_RGBA: return 4;
+            default: break;
+        }
+    }
+    else if ((type == SW_UNSIGNED_SHORT_5_6_5) && (format == SW_RGB)) return 2;
+    else if (((type == SW_UNSIGNED_SHORT_5_5_5_1) || (type == SW_UNSIGNED_SHORT_4_4_4_4)) && (format == SW_RGBA)) return 2;
+
+    return 0;
+}
+
+// Convert external pixel data rows to RGBA
+static void swConvertToRGBA(unsigned char *dst, int dstStride, const unsigned char *src, int width, int height, int format, int type)
+{
+    int pixelSize = swGetPixelSize(format, type);
+    int srcStride = width*pixelSize;
+    srcStride = (srcStride + SW.unpackAlignment - 1)/SW.unpackAlignment*SW.unpackAlignment;
+
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *in = src + y*srcStride;
+        unsigned char *out = dst + y*dstStride;
+
+        for (int x = 0; x < width; x++, in += pixelSize, out += 4)
+        {
+            unsigned short value = 0;
+            if (pixelSize == 2) memcpy(&value, in, 2);
+
+            if (type == SW_UNSIGNED_SHORT_5_6_5)
+            {
+                out[0] = (unsigned char)(((value >> 11) & 0x1f)*255/31);
+                out[1] = (unsigned char)(((value >> 5) & 0x3f)*255/63);
+                out[2] = (unsigned char)((value & 0x1f)*255/31);
+                out[3] = 255;
+            }
+            else if (type == SW_UNSIGNED_SHORT_5_5_5_1)
+            {
+                out[0] = (unsigned char)(((value >> 11) & 0x1f)*255/31);
+                out[1] = (unsigned char)(((value >> 6) & 0x1f)*255/31);
+                out[2] = (unsigned char)(((value >> 1) & 0x1f)*255/31);
+                out[3] = (value & 0x1)? 255 : 0;
+            }
+            else if (type == SW_UNSIGNED_SHORT_4_4_4_4)
+            {
+                out[0] = (unsigned char)(((value >> 12) & 0xf)*17);
+                out[1] = (unsigned char)(((value >> 8) & 0xf)*17);
+                out[2] = (unsigned char)(((value >> 4) & 0xf)*17);
+                out[3] = (unsigned char)((value & 0xf)*17);
+            }
+            else
+            {
+                switch (format)
+                {
+                    case SW_LUMINANCE: out[0] = out[1] = out[2] = in[0]; out[3] = 255; break;
+                    case SW_LUMINANCE_ALPHA: out[0] = out[1] = out[2] = in[0]; out[3] = in[1]; break;
+                    case SW_RGB: out[0] = in[0]; out[1] = in[1]; out[2] = in[2]; out[3] = 255; break;
+                    default: memcpy(out, in, 4); break;
+                }
+            }
+        }
+    }
+}
+
+// Convert RGBA rows to external pixel data
+static void swConvertFromRGBA(unsigned char *dst, const unsigned char *src, int srcStride, int width, int height, int format, int type)
+{
+    int pixelSize = swGetPixelSize(format, type);
+    int dstStride = width*pixelSize;
+    dstStride = (dstStride + SW.packAlignment - 1)/SW.packAlignment*SW.packAlignment;
+
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *in = src + y*srcStride;
+        unsigned char *out = dst + y*dstStride;
+
+        for (int x = 0; x < width; x++, in += 4, out += pixelSize)
+        {
+            unsigned short value = 0;
+
+            if (type == SW_UNSIGNED_SHORT_5_6_5) value = (unsigned short)(((in[0]*31 + 127)/255 << 11) | ((in[1]*63 + 127)/255 << 5) | ((in[2]*31 + 127)/255));
+            else if (type == SW_UNSIGNED_SHORT_5_5_5_1) value = (unsigned short)(((in[0]*31 + 127)/255 << 11) | ((in[1]*31 + 127)/255 << 6) | ((in[2]*31 + 127)/255 << 1) | ((in[3] > 127)? 1 : 0));
+            else if (type == SW_UNSIGNED_SHORT_4_4_4_4) value = (unsigned short)(((in[0] + 8)/17 << 12) | ((in[1] + 8)/17 << 8) | ((in[2] + 8)/17 << 4) | ((in[3] + 8)/17));
+            else
+            {
+                switch (format)
+                {
+                    case SW_LUMINANCE: out[0] = in[0]; break;
+                    case SW_LUMINANCE_ALPHA: out[0] = in[0]; out[1] = in[3]; break;
+                    case SW_RGB: out[0] = in[0]; out[1] = in[1]; out[2] = in[2]; break;
+                    default: memcpy(out, in, 4); break;
+                }
+            }
+
+            if (pixelSize == 2 && (type != SW_UNSIGNED_BYTE)) memcpy(out, &value, 2);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Context management
+//----------------------------------------------------------------------------------
+
+// Allocate framebuffer and tiles for given size
+static bool swAllocateFramebuffer(int width, int height)
+{
+    int tilesX = (width + RLSW_TILE_SIZE - 1)/RLSW_TILE_SIZE;
+    int tilesY = (height + RLSW_TILE_SIZE - 1)/RLSW_TILE_SIZE;
+
+    unsigned int *colorBuffer = (unsigned int *)SW_CALLOC(width*height, sizeof(unsigned int));
+    float *depthBuffer = (float *)SW_MALLOC(width*height*sizeof(float));
+    swTileBin *bins = (swTileBin *)SW_CALLOC(tilesX*tilesY, sizeof(swTileBin));
+
+    if ((colorBuffer == NULL) || (depthBuffer == NULL) || (bins == NULL))
+    {
+        SW_FREE(colorBuffer);
+        SW_FREE(depthBuffer);
+        SW_FREE(bins);
+        return false;
+    }
+
+    for (int i = 0; i < width*height; i++) depthBuffer[i] = 1.0f;
+
+    if (SW.bins != NULL)
+    {
+        for (int i = 0; i < SW.tilesX*SW.tilesY; i++) SW_FREE(SW.bins[i].items);
+    }
+
+    SW_FREE(SW.colorBuffer);
+    SW_FREE(SW.depthBuffer);
+    SW_FREE(SW.bins);
+
+    SW.width = width;
+    SW.height = height;
+    SW.colorBuffer = colorBuffer;
+    SW.depthBuffer = depthBuffer;
+    SW.tilesX = tilesX;
+    SW.tilesY = tilesY;
+    SW.bins = bins;
+
+    swUpdateClipBounds();
+
+    return true;
+}
+
+// Initialize rasterizer with a framebuffer of given size
+int swInit(int width, int height)
+{
+    if ((width <= 0) || (height <= 0)) return 0;
+
+    memset(&SW, 0, sizeof(SW));
+
+    if (!swAllocateFramebuffer(width, height)) return 0;
+
+    // Init default state (same as OpenGL defaults)
+    SW.viewport[2] = SW.scissor[2] = width;
+    SW.viewport[3] = SW.scissor[3] = height;
+    SW.srcFactor = SW_ONE;
+    SW.dstFactor = SW_ZERO;
+    SW.depthMask = true;
+    SW.depthFunc = SW_LESS;
+    SW.cullMode = SW_BACK;
+    SW.frontFace = SW_CCW;
+    SW.polygonMode = SW_FILL;
+    SW.lineWidth = 1.0f;
+    SW.clearDepth = 1.0f;
+    SW.unpackAlignment = 4;
+    SW.packAlignment = 4;
+    SW.stateDirty = true;
+    SW.color[0] = SW.color[1] = SW.color[2] = SW.color[3] = 1.0f;
+
+    for (int i = 0; i < 3; i++) swMatrixIdentity(SW.stacks[i][0]);
+    SW.mvpDirty = true;
+    SW.textureMatrixIdentity = true;
+
+    swUpdateClipBounds();
+
+    // Init worker threads, calling thread also rasterizes tiles on flush
+    swMutexInit(&SW.lock);
+    swCondInit(&SW.startCond);
+    swCondInit(&SW.doneCond);
+
+    for (int i = 0; i < (RLSW_MAX_THREADS - 1); i++)
+    {
+        if (!swThreadCreate(&SW.workers[SW.workerCount])) break;
+        SW.workerCount++;
+    }
+
+    return 1;
+}
+
+// Close rasterizer, worker threads stopped and memory freed
+void swClose(void)
+{
+    if (SW.colorBuffer == NULL) return;
+
+    swMutexLock(&SW.lock);
+    SW.quit = true;
+    swCondBroadcast(&SW.startCond);
+    swMutexUnlock(&SW.lock);
+
+    for (int i = 0; i < SW.workerCount; i++) swThreadJoin(SW.workers[i]);
+
+    swCondDestroy(&SW.startCond);
+    swCondDestroy(&SW.doneCond);
+    swMutexDestroy(&SW.lock);
+
+    for (int i = 0; i < SW.tilesX*SW.tilesY; i++) SW_FREE(SW.bins[i].items);
+
+    for (int i = 0; i < SW.textureCapacity; i++)
+    {
+        if (SW.textures[i] != NULL) SW_FREE(SW.textures[i]->pixels);
+        SW_FREE(SW.textures[i]);
+    }
+
+    SW_FREE(SW.textures);
+    SW_FREE(SW.bins);
+    SW_FREE(SW.primitives);
+    SW_FREE(SW.states);
+    SW_FREE(SW.colorBuffer);
+    SW_FREE(SW.depthBuffer);
+
+    memset(&SW, 0, sizeof(SW));
+}
+
+// Resize framebuffer (content discarded)
+int swResize(int width, int height)
+{
+    if ((width <= 0) || (height <= 0)) return 0;
+
+    swFlush();
+    return swAllocateFramebuffer(width, height)? 1 : 0;
+}
+
+// Get framebuffer RGBA pixels (bottom row first)
+unsigned char *swGetColorBuffer(int *width, int *height)
+{
+    swFlush();
+
+    if (width != NULL) *width = SW.width;
+    if (height != NULL) *height = SW.height;
+
+    return (unsigned char *)SW.colorBuffer;
+}
+
+// Draw all pending primitives
+// NOTE: Tiles are shared among worker threads and calling thread, every tile draws
+// its primitives in submission order, tiles do not share pixels
+void swFlush(void)
+{
+    if (SW.primitiveCount == 0) return;
+
+    SW.nextTile = 0;
+
+    if (SW.workerCount > 0)
+    {
+        swMutexLock(&SW.lock);
+        SW.jobId++;
+        SW.jobsRunning = SW.workerCount;
+        swCondBroadcast(&SW.startCond);
+        swMutexUnlock(&SW.lock);
+    }
+
+    swRasterizeTiles();
+
+    if (SW.workerCount > 0)
+    {
+        swMutexLock(&SW.lock);
+        while (SW.jobsRunning > 0) swCondWait(&SW.doneCond, &SW.lock);
+        swMutexUnlock(&SW.lock);
+    }
+
+    for (int i = 0; i < SW.tilesX*SW.tilesY; i++) SW.bins[i].count = 0;
+
+    SW.primitiveCount = 0;
+    SW.stateCount = 0;
+    SW.stateDirty = true;
+}
+
+void swFinish(void) { swFlush(); }
+
+// Get and reset last error
+int swGetError(void)
+{
+    int error = SW.error;
+    SW.error = SW_NO_ERROR;
+    return error;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - State management
+//----------------------------------------------------------------------------------
+static void swSetCapability(int cap, bool enabled)
+{
+    switch (cap)
+    {
+        case SW_BLEND: SW.blend = enabled; SW.stateDirty = true; break;
+        case SW_DEPTH_TEST: SW.depthTest = enabled; SW.stateDirty = true; break;
+        case SW_TEXTURE_2D: SW.texture2D = enabled; SW.stateDirty = true; break;
+        case SW_SCISSOR_TEST: SW.scissorTest = enabled; swUpdateClipBounds(); break;
+        case SW_CULL_FACE: SW.cullFace = enabled; break;
+        case SW_LINE_SMOOTH: break;
+        default: swSetError(SW_INVALID_ENUM); break;
+    }
+}
+
+void swEnable(int cap) { swSetCapability(cap, true); }
+void swDisable(int cap) { swSetCapability(cap, false); }
+
+void swViewport(int x, int y, int width, int height)
+{
+    if ((width < 0) || (height < 0)) { swSetError(SW_INVALID_VALUE); return; }
+
+    SW.viewport[0] = x;
+    SW.viewport[1] = y;
+    SW.viewport[2] = width;
+    SW.viewport[3] = height;
+    swUpdateClipBounds();
+}
+
+void swScissor(int x, int y, int width, int height)
+{
+    if ((width < 0) || (height < 0)) { swSetError(SW_INVALID_VALUE); return; }
+
+    SW.scissor[0] = x;
+    SW.scissor[1] = y;
+    SW.scissor[2] = width;
+    SW.scissor[3] = height;
+    swUpdateClipBounds();
+}
+
+void swClearColor(float r, float g, float b, float a)
+{
+    SW.clearColor[0] = r;
+    SW.clearColor[1] = g;
+    SW.clearColor[2] = b;
+    SW.clearColor[3] = a;
+}
+
+void swClearDepth(double depth)
+{
+    SW.clearDepth = (depth < 0.0)? 0.0f : ((depth > 1.0)? 1.0f : (float)depth);
+}
+
+// Clear color and/or depth buffers
+// NOTE: Clear is binned like any other primitive, it keeps its order and it is split among tiles
+void swClear(unsigned int mask)
+{
+    mask &= (SW_COLOR_BUFFER_BIT | SW_DEPTH_BUFFER_BIT);
+    if (mask == 0) return;
+
+    int bounds[4] = { 0, 0, SW.width - 1, SW.height - 1 };
+
+    if (SW.scissorTest)
+    {
+        bounds[0] = SW_MAX(bounds[0], SW.scissor[0]);
+        bounds[1] = SW_MAX(bounds[1], SW.scissor[1]);
+        bounds[2] = SW_MIN(bounds[2], SW.scissor[0] + SW.scissor[2] - 1);
+        bounds[3] = SW_MIN(bounds[3], SW.scissor[1] + SW.scissor[3] - 1);
+    }
+
+    if ((bounds[0] > bounds[2]) || (bounds[1] > bounds[3])) return;
+
+    swPrimitive *primitive = swPushPrimitive(SW_PRIMITIVE_CLEAR, bounds);
+    if (primitive == NULL) return;
+
+    primitive->setup.clear.color = swPackColor(SW.clearColor);
+    primitive->setup.clear.depth = SW.clearDepth;
+    primitive->setup.clear.mask = mask;
+}
+
+void swBlendFunc(int sfactor, int dfactor)
+{
+    SW.srcFactor = sfactor;
+    SW.dstFactor = dfactor;
+    SW.stateDirty = true;
+}
+
+void swDepthFunc(int func)
+{
+    if ((func < SW_NEVER) || (func > SW_ALWAYS)) { swSetError(SW_INVALID_ENUM); return; }
+
+    SW.depthFunc = func;
+    SW.stateDirty = true;
+}
+
+void swDepthMask(unsigned char flag)
+{
+    SW.depthMask = (flag != 0);
+    SW.stateDirty = true;
+}
+
+void swCullFace(int mode) { SW.cullMode = mode; }
+void swFrontFace(int mode) { SW.frontFace = mode; }
+
+void swPolygonMode(int face, int mode)
+{
+    (void)face;
+    if ((mode == SW_LINE) || (mode == SW_FILL)) SW.polygonMode = mode;
+    else swSetError(SW_INVALID_ENUM);
+}
+
+void swLineWidth(float width)
+{
+    if (width <= 0.0f) { swSetError(SW_INVALID_VALUE); return; }
+    SW.lineWidth = width;
+}
+
+void swHint(int target, int mode) { (void)target; (void)mode; }
+void swShadeModel(int mode) { (void)mode; }
+
+void swPixelStorei(int pname, int param)
+{
+    if ((param != 1) && (param != 2) && (param != 4) && (param != 8)) { swSetError(SW_INVALID_VALUE); return; }
+
+    if (pname == SW_UNPACK_ALIGNMENT) SW.unpackAlignment = param;
+    else if (pname == SW_PACK_ALIGNMENT) SW.packAlignment = param;
+    else swSetError(SW_INVALID_ENUM);
+}
+
+void swGetFloatv(int pname, float *params)
+{
+    switch (pname)
+    {
+        case SW_LINE_WIDTH: params[0] = SW.lineWidth; break;
+        case SW_MODELVIEW_MATRIX: memcpy(params, SW.stacks[0][SW.stackDepth[0]], 16*sizeof(float)); break;
+        case SW_PROJECTION_MATRIX: memcpy(params, SW.stacks[1][SW.stackDepth[1]], 16*sizeof(float)); break;
+        case SW_TEXTURE_MATRIX: memcpy(params, SW.stacks[2][SW.stackDepth[2]], 16*sizeof(float)); break;
+        default: swSetError(SW_INVALID_ENUM); break;
+    }
+}
+
+const unsigned char *swGetString(int name)
+{
+    switch (name)
+    {
+        case SW_VENDOR: return (const unsigned char *)"raylib";
+        case SW_RENDERER: return (const unsigned char *)"rlsw software rasterizer";
+        case SW_VERSION: return (const unsigned char *)"1.1 rlsw " RLSW_VERSION;
+        case SW_EXTENSIONS: return (const unsigned char *)"";
+        case SW_SHADING_LANGUAGE_VERSION: return (const unsigned char *)"none";
+        default: swSetError(SW_INVALID_ENUM); break;
+    }
+
+    return NULL;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Matrix operations
+//----------------------------------------------------------------------------------
+void swMatrixMode(int mode)
+{
+    switch (mode)
+    {
+        case SW_MODELVIEW: SW.matrixMode = 0; break;
+        case SW_PROJECTION: SW.matrixMode = 1; break;
+        case SW_TEXTURE: SW.matrixMode = 2; break;
+        default: swSetError(SW_INVALID_ENUM); break;
+    }
+}
+
+void swPushMatrix(void)
+{
+    int *depth = &SW.stackDepth[SW.matrixMode];
+    if (*depth >= (RLSW_MAX_MATRIX_STACK_SIZE - 1)) { swSetError(SW_STACK_OVERFLOW); return; }
+
+    memcpy(SW.stacks[SW.matrixMode][*depth + 1], SW.stacks[SW.matrixMode][*depth], 16*sizeof(float));
+    (*depth)++;
+}
+
+void swPopMatrix(void)
+{
+    int *depth = &SW.stackDepth[SW.matrixMode];
+    if (*depth == 0) { swSetError(SW_STACK_UNDERFLOW); return; }
+
+    (*depth)--;
+
+    if (SW.matrixMode == 2) SW.textureMatrixIdentity = false;
+    else SW.mvpDirty = true;
+}
+
+void swLoadIdentity(void)
+{
+    swMatrixIdentity(SW.stacks[SW.matrixMode][SW.stackDepth[SW.matrixMode]]);
+
+    if (SW.matrixMode == 2) SW.textureMatrixIdentity = (SW.stackDepth[2] == 0);
+    else SW.mvpDirty = true;
+}
+
+void swTranslatef(float x, float y, float z)
+{
+    float mat[16];
+    swMatrixIdentity(mat);
+    mat[12] = x;
+    mat[13] = y;
+    mat[14] = z;
+    swMultiplyCurrent(mat);
+}
+
+void swRotatef(float angle, float x, float y, float z)
+{
+    float length = sqrtf(x*x + y*y + z*z);
+    if (length == 0.0f) return;
+
+    x /= length;
+    y /= length;
+    z /= length;
+
+    float radians = angle*3.14159265358979323846f/180.0f;
+    float s = sinf(radians);
+    float c = cosf(radians);
+    float t = 1.0f - c;
+
+    float mat[16] = {
+        x*x*t + c,   y*x*t + z*s, z*x*t - y*s, 0.0f,
+        x*y*t - z*s, y*y*t + c,   z*y*t + x*s, 0.0f,
+        x*z*t + y*s, y*z*t - x*s, z*z*t + c,   0.0f,
+        0.0f,        0.0f,        0.0f,        1.0f
+    };
+
+    swMultiplyCurrent(mat);
+}
+
+void swScalef(float x, float y, float z)
+{
+    float mat[16];
+    swMatrixIdentity(mat);
+    mat[0] = x;
+    mat[5] = y;
+    mat[10] = z;
+    swMultiplyCurrent(mat);
+}
+
+void swMultMatrixf(const float *matf) { swMultiplyCurrent(matf); }
+
+void swOrtho(double left, double right, double bottom, double top, double znear, double zfar)
+{
+    if ((left == right) || (bottom == top) || (znear == zfar)) { swSetError(SW_INVALID_VALUE); return; }
+
+    float mat[16];
+    swMatrixIdentity(mat);
+    mat[0] = (float)(2.0/(right - left));
+    mat[5] = (float)(2.0/(top - bottom));
+    mat[10] = (float)(-2.0/(zfar - znear));
+    mat[12] = (float)(-(right + left)/(right - left));
+    mat[13] = (float)(-(top + bottom)/(top - bottom));
+    mat[14] = (float)(-(zfar + znear)/(zfar - znear));
+    swMultiplyCurrent(mat);
+}
+
+void swFrustum(double left, double right, double bottom, double top, double znear, double zfar)
+{
+    if ((znear <= 0.0) || (zfar <= 0.0) || (left == right) || (bottom == top) || (znear == zfar)) { swSetError(SW_INVALID_VALUE); return; }
+
+    float mat[16] = { 0 };
+    mat[0] = (float)(2.0*znear/(right - left));
+    mat[5] = (float)(2.0*znear/(top - bottom));
+    mat[8] = (float)((right + left)/(right - left));
+    mat[9] = (float)((top + bottom)/(top - bottom));
+    mat[10] = (float)(-(zfar + znear)/(zfar - znear));
+    mat[11] = -1.0f;
+    mat[14] = (float)(-2.0*zfar*znear/(zfar - znear));
+    swMultiplyCurrent(mat);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Immediate mode
+//----------------------------------------------------------------------------------
+void swBegin(int mode)
+{
+    if ((mode != SW_LINES) && (mode != SW_TRIANGLES) && (mode != SW_QUADS))
+    {
+        swSetError(SW_INVALID_ENUM);
+        mode = 0;
+    }
+
+    SW.primitiveMode = mode;
+    SW.vertexCount = 0;
+}
+
+void swEnd(void)
+{
+    SW.primitiveMode = 0;
+    SW.vertexCount = 0;
+}
+
+void swVertex2i(int x, int y) { swSubmitVertex((float)x, (float)y, 0.0f, SW.texcoord, SW.color); }
+void swVertex2f(float x, float y) { swSubmitVertex(x, y, 0.0f, SW.texcoord, SW.color); }
+void swVertex3f(float x, float y, float z) { swSubmitVertex(x, y, z, SW.texcoord, SW.color); }
+
+void swTexCoord2f(float x, float y)
+{
+    SW.texcoord[0] = x;
+    SW.texcoord[1] = y;
+}
+
+void swNormal3f(float x, float y, float z) { (void)x; (void)y; (void)z; }
+
+void swColor3f(float r, float g, float b) { swColor4f(r, g, b, 1.0f); }
+
+void swColor4f(float r, float g, float b, float a)
+{
+    SW.color[0] = r;
+    SW.color[1] = g;
+    SW.color[2] = b;
+    SW.color[3] = a;
+}
+
+void swColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+    swColor4f(r/255.0f, g/255.0f, b/255.0f, a/255.0f);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Vertex arrays
+//----------------------------------------------------------------------------------
+static swArray *swGetArray(int array)
+{
+    switch (array)
+    {
+        case SW_VERTEX_ARRAY: return &SW.vertexArray;
+        case SW_TEXTURE_COORD_ARRAY: return &SW.texcoordArray;
+        case SW_COLOR_ARRAY: return &SW.colorArray;
+        default: break;
+    }
+
+    return NULL;
+}
+
+void swEnableClientState(int array)
+{
+    swArray *arr = swGetArray(array);
+    if (arr != NULL) arr->enabled = true;
+}
+
+void swDisableClientState(int array)
+{
+    swArray *arr = swGetArray(array);
+    if (arr != NULL) arr->enabled = false;
+}
+
+static void swSetArray(swArray *arr, int size, int type, int stride, const void *pointer)
+{
+    arr->size = size;
+    arr->type = type;
+    arr->stride = stride;
+    arr->pointer = (const unsigned char *)pointer;
+}
+
+void swVertexPointer(int size, int type, int stride, const void *pointer) { swSetArray(&SW.vertexArray, size, type, stride, pointer); }
+void swTexCoordPointer(int size, int type, int stride, const void *pointer) { swSetArray(&SW.texcoordArray, size, type, stride, pointer); }
+void swColorPointer(int size, int type, int stride, const void *pointer) { swSetArray(&SW.colorArray, size, type, stride, pointer); }
+void swNormalPointer(int type, int stride, const void *pointer) { (void)type; (void)stride; (void)pointer; }
+
+// Read array element components as floats, bytes are normalized
+static void swReadArray(const swArray *arr, int index, float *values, int count)
+{
+    int componentSize = (arr->type == SW_UNSIGNED_BYTE)? 1 : sizeof(float);
+    int stride = (arr->stride > 0)? arr->stride : arr->size*componentSize;
+    const unsigned char *element = arr->pointer + (size_t)index*stride;
+
+    for (int i = 0; (i < arr->size) && (i < count); i++)
+    {
+        if (arr->type == SW_UNSIGNED_BYTE) values[i] = element[i]/255.0f;
+        else memcpy(&values[i], element + i*sizeof(float), sizeof(float));
+    }
+}
+
+static void swSubmitArrayVertex(int index)
+{
+    float position[3] = { 0.0f, 0.0f, 0.0f };
+    float texcoord[2] = { SW.texcoord[0], SW.texcoord[1] };
+    float color[4] = { SW.color[0], SW.color[1], SW.color[2], SW.color[3] };
+
+    swReadArray(&SW.vertexArray, index, position, 3);
+    if (SW.texcoordArray.enabled && (SW.texcoordArray.pointer != NULL)) swReadArray(&SW.texcoordArray, index, texcoord, 2);
+    if (SW.colorArray.enabled && (SW.colorArray.pointer != NULL))
+    {
+        color[3] = 1.0f;
+        swReadArray(&SW.colorArray, index, color, 4);
+    }
+
+    swSubmitVertex(position[0], position[1], position[2], texcoord, color);
+}
+
+void swDrawArrays(int mode, int first, int count)
+{
+    if (!SW.vertexArray.enabled || (SW.vertexArray.pointer == NULL)) return;
+    if ((first < 0) || (count < 0)) { swSetError(SW_INVALID_VALUE); return; }
+
+    swBegin(mode);
+    for (int i = 0; i < count; i++) swSubmitArrayVertex(first + i);
+    swEnd();
+}
+
+void swDrawElements(int mode, int count, int type, const void *indices)
+{
+    if (!SW.vertexArray.enabled || (SW.vertexArray.pointer == NULL) || (indices == NULL)) return;
+    if (count < 0) { swSetError(SW_INVALID_VALUE); return; }
+
+    swBegin(mode);
+    for (int i = 0; i < count; i++)
+    {
+        int index = 0;
+
+        switch (type)
+        {
+            case SW_UNSIGNED_BYTE: index = ((const unsigned char *)indices)[i]; break;
+            case SW_UNSIGNED_SHORT: index = ((const unsigned short *)indices)[i]; break;
+            case SW_UNSIGNED_INT: index = (int)((const unsigned int *)indices)[i]; break;
+            default: swSetError(SW_INVALID_ENUM); swEnd(); return;
+        }
+
+        swSubmitArrayVertex(index);
+    }
+    swEnd();
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Textures
+//----------------------------------------------------------------------------------
+void swGenTextures(int count, unsigned int *textures)
+{
+    for (int i = 0; i < count; i++)
+    {
+        unsigned int id = SW.textureCounter + 1;
+
+        if ((int)id >= SW.textureCapacity)
+        {
+            int capacity = (SW.textureCapacity == 0)? 64 : SW.textureCapacity*2;
+            swTexture **resized = (swTexture **)SW_REALLOC(SW.textures, capacity*sizeof(swTexture *));
+            if (resized == NULL) { swSetError(SW_OUT_OF_MEMORY); textures[i] = 0; continue; }
+
+            memset(resized + SW.textureCapacity, 0, (capacity - SW.textureCapacity)*sizeof(swTexture *));
+            SW.textures = resized;
+            SW.textureCapacity = capacity;
+        }
+
+        swTexture *texture = (swTexture *)SW_CALLOC(1, sizeof(swTexture));
+        if (texture == NULL) { swSetError(SW_OUT_OF_MEMORY); textures[i] = 0; continue; }
+
+        // NOTE: OpenGL default minification filter uses mipmaps, not available, nearest used instead
+        texture->minFilter = SW_NEAREST;
+        texture->magFilter = SW_LINEAR;
+        texture->wrapS = SW_REPEAT;
+        texture->wrapT = SW_REPEAT;
+
+        SW.textures[id] = texture;
+        SW.textureCounter = id;
+        textures[i] = id;
+    }
+}
+
+void swDeleteTextures(int count, const unsigned int *textures)
+{
+    // Pending primitives could be using deleted textures
+    swFlush();
+
+    for (int i = 0; i < count; i++)
+    {
+        unsigned int id = textures[i];
+        if ((id == 0) || ((int)id >= SW.textureCapacity) || (SW.textures[id] == NULL)) continue;
+
+        SW_FREE(SW.textures[id]->pixels);
+        SW_FREE(SW.textures[id]);
+        SW.textures[id] = NULL;
+
+        if (SW.boundTexture == id) SW.boundTexture = 0;
+    }
+
+    SW.stateDirty = true;
+}
+
+void swBindTexture(int target, unsigned int texture)
+{
+    if (target != SW_TEXTURE_2D) { swSetError(SW_INVALID_ENUM); return; }
+
+    SW.boundTexture = texture;
+    SW.stateDirty = true;
+}
+
+static swTexture *swGetBoundTexture(void)
+{
+    if ((SW.boundTexture == 0) || ((int)SW.boundTexture >= SW.textureCapacity)) return NULL;
+    return SW.textures[SW.boundTexture];
+}
+
+// Load texture base level, other mipmap levels are accepted and ignored
+void swTexImage2D(int target, int level, int internalFormat, int width, int height, int border, int format, int type, const void *pixels)
+{
+    (void)internalFormat;
+    (void)border;
+
+    swTexture *texture = swGetBoundTexture();
+
+    if ((target != SW_TEXTURE_2D) || (texture == NULL)) { swSetError(SW_INVALID_OPERATION); return; }
+    if (swGetPixelSize(format, type) == 0) { swSetError(SW_INVALID_ENUM); return; }
+    if ((width < 0) || (height < 0)) { swSetError(SW_INVALID_VALUE); return; }
+    if (level > 0) return;
+
+    // Pending primitives could be using previous texture data
+    swFlush();
+
+    unsigned char *data = (unsigned char *)SW_CALLOC((size_t)width*height, 4);
+    if ((data == NULL) && (width*height > 0)) { swSetError(SW_OUT_OF_MEMORY); return; }
+
+    if (pixels != NULL) swConvertToRGBA(data, width*4, (const unsigned char *)pixels, width, height, format, type);
+
+    SW_FREE(texture->pixels);
+    texture->pixels = data;
+    texture->width = width;
+    texture->height = height;
+}
+
+void swTexSubImage2D(int target, int level, int offsetX, int offsetY, int width, int height, int format, int type, const void *pixels)
+{
+    swTexture *texture = swGetBoundTexture();
+
+    if ((target != SW_TEXTURE_2D) || (texture == NULL) || (texture->pixels == NULL)) { swSetError(SW_INVALID_OPERATION); return; }
+    if (swGetPixelSize(format, type) == 0) { swSetError(SW_INVALID_ENUM); return; }
+    if ((offsetX < 0) || (offsetY < 0) || (width < 0) || (height < 0) ||
+        ((offsetX + width) > texture->width) || ((offsetY + height) > texture->height)) { swSetError(SW_INVALID_VALUE); return; }
+    if ((level > 0) || (pixels == NULL)) return;
+
+    swFlush();
+
+    swConvertToRGBA(texture->pixels + (offsetY*texture->width + offsetX)*4, texture->width*4, (const unsigned char *)pixels, width, height, format, type);
+}
+
+void swTexParameteri(int target, int pname, int param)
+{
+    swTexture *texture = swGetBoundTexture();
+    if ((target != SW_TEXTURE_2D) || (texture == NULL)) { swSetError(SW_INVALID_OPERATION); return; }
+
+    // NOTE: Texture parameters are read when tiles are rasterized
+    swFlush();
+
+    switch (pname)
+    {
+        case SW_TEXTURE_MIN_FILTER: texture->minFilter = param; break;
+        case SW_TEXTURE_MAG_FILTER: texture->magFilter = param; break;
+        case SW_TEXTURE_WRAP_S: texture->wrapS = param; break;
+        case SW_TEXTURE_WRAP_T: texture->wrapT = param; break;
+        default: swSetError(SW_INVALID_ENUM); break;
+    }
+}
+
+void swGetTexImage(int target, int level, int format, int type, void *pixels)
+{
+    swTexture *texture = swGetBoundTexture();
+
+    if ((target != SW_TEXTURE_2D) || (texture == NULL)) { swSetError(SW_INVALID_OPERATION); return; }
+    if (swGetPixelSize(format, type) == 0) { swSetError(SW_INVALID_ENUM); return; }
+    if ((level > 0) || (texture->pixels == NULL) || (pixels == NULL)) return;
+
+    swConvertFromRGBA((unsigned char *)pixels, texture->pixels, texture->width*4, texture->width, texture->height, format, type);
+}
+
+// Read framebuffer pixels, rows from bottom to top (OpenGL window coordinates)
+void swReadPixels(int x, int y, int width, int height, int format, int type, void *pixels)
+{
+    if (swGetPixelSize(format, type) == 0) { swSetError(SW_INVALID_ENUM); return; }
+    if ((width < 0) || (height < 0)) { swSetError(SW_INVALID_VALUE); return; }
+    if ((pixels == NULL) || (x < 0) || (y < 0) || ((x + width) > SW.width) || ((y + height) > SW.height)) return;
+
+    swFlush();
+
+    swConvertFromRGBA((unsigned char *)pixels, (const unsigned char *)(SW.colorBuffer + y*SW.width + x), SW.width*4, width, height, format, type);
+}
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Definition - Primitives submission
+//----------------------------------------------------------------------------------
+
+// Update primitives clip bounds: viewport, scissor and framebuffer intersection
+static void swUpdateClipBounds(void)
+{
+    SW.clipBounds[0] = SW_MAX(0, SW.viewport[0]);
+    SW.clipBounds[1] = SW_MAX(0, SW.viewport[1]);
+    SW.clipBounds[2] = SW_MIN(SW.width - 1, SW.viewport[0] + SW.viewport[2] - 1);
+    SW.clipBounds[3] = SW_MIN(SW.height - 1, SW.viewport[1] + SW.viewport[3] - 1);
+
+    if (SW.scissorTest)
+    {
+        SW.clipBounds[0] = SW_MAX(SW.clipBounds[0], SW.scissor[0]);
+        SW.clipBounds[1] = SW_MAX(SW.clipBounds[1], SW.scissor[1]);
+        SW.clipBounds[2] = SW_MIN(SW.clipBounds[2], SW.scissor[0] + SW.scissor[2] - 1);
+        SW.clipBounds[3] = SW_MIN(SW.clipBounds[3], SW.scissor[1] + SW.scissor[3] - 1);
+    }
+}
+
+// Add primitive and bin it into tiles it covers
+// NOTE: Pending primitives are drawn when buffer is full, returns NULL if out of memory
+static swPrimitive *swPushPrimitive(int type, const int *bounds)
+{
+    if (SW.primitiveCount >= SW.primitiveCapacity)
+    {
+        if (SW.primitiveCapacity >= RLSW_MAX_PRIMITIVES) swFlush();
+        else
+        {
+            int capacity = (SW.primitiveCapacity == 0)? 1024 : SW_MIN(SW.primitiveCapacity*2, RLSW_MAX_PRIMITIVES);
+            swPrimitive *primitives = (swPrimitive *)SW_REALLOC(SW.primitives, capacity*sizeof(swPrimitive));
+            if (primitives == NULL) { swSetError(SW_OUT_OF_MEMORY); return NULL; }
+
+            SW.primitives = primitives;
+            SW.primitiveCapacity = capacity;
+        }
+    }
+
+    // Render state captured once until it changes, never more states than primitives
+    if (SW.stateDirty || (SW.stateCount == 0))
+    {
+        if (SW.stateCount >= SW.stateCapacity)
+        {
+            swRenderState *states = (swRenderState *)SW_REALLOC(SW.states, SW.primitiveCapacity*sizeof(swRenderState));
+            if (states == NULL) { swSetError(SW_OUT_OF_MEMORY); return NULL; }
+
+            SW.states = states;
+            SW.stateCapacity = SW.primitiveCapacity;
+        }
+
+        swRenderState *state = &SW.states[SW.stateCount++];
+        state->texture = SW.texture2D? swGetBoundTexture() : NULL;
+        if ((state->texture != NULL) && (state->texture->pixels == NULL)) state->texture = NULL;
+        state->blend = SW.blend;
+        state->srcFactor = SW.srcFactor;
+        state->dstFactor = SW.dstFactor;
+        state->depthTest = SW.depthTest;
+        state->depthMask = SW.depthMask;
+        state->depthFunc = SW.depthFunc;
+
+        SW.stateDirty = false;
+    }
+
+    int tileMinX = bounds[0]/RLSW_TILE_SIZE;
+    int tileMinY = bounds[1]/RLSW_TILE_SIZE;
+    int tileMaxX = bounds[2]/RLSW_TILE_SIZE;
+    int tileMaxY = bounds[3]/RLSW_TILE_SIZE;
+
+    for (int ty = tileMinY; ty <= tileMaxY; ty++)
+    {
+        for (int tx = tileMinX; tx <= tileMaxX; tx++)
+        {
+            swTileBin *bin = &SW.bins[ty*SW.tilesX + tx];
+
+            if (bin->count >= bin->capacity)
+            {
+                int capacity = (bin->capacity == 0)? 64 : bin->capacity*2;
+                int *items = (int *)SW_REALLOC(bin->items, capacity*sizeof(int));
+                if (items == NULL) { swSetError(SW_OUT_OF_MEMORY); continue; }
+
+                bin->items = items;
+                bin->capacity = capacity;
+            }
+
+            bin->items[bin->count++] = SW.primitiveCount;
+        }
+    }
+
+    swPrimitive *primitive = &SW.primitives[SW.primitiveCount++];
+    primitive->type = type;
+    primitive->state = SW.stateCount - 1;
+    memcpy(primitive->bounds, bounds, 4*sizeof(int));
+
+    return primitive;
+}
+
+// Transform vertex to clip space and assemble primitives
+static void swSubmitVertex(float x, float y, float z, const float *texcoord, const float *color)
+{
+    if (SW.primitiveMode == 0) return;
+
+    if (SW.mvpDirty)
+    {
+        swMatrixMultiply(SW.mvp, SW.stacks[1][SW.stackDepth[1]], SW.stacks[0][SW.stackDepth[0]]);
+        SW.mvpDirty = false;
+    }
+
+    const float *m = SW.mvp;
+    swVertex *vertex = &SW.vertices[SW.vertexCount++];
+
+    vertex->position[0] = m[0]*x + m[4]*y + m[8]*z + m[12];
+    vertex->position[1] = m[1]*x + m[5]*y + m[9]*z + m[13];
+    vertex->position[2] = m[2]*x + m[6]*y + m[10]*z + m[14];
+    vertex->position[3] = m[3]*x + m[7]*y + m[11]*z + m[15];
+
+    if (SW.textureMatrixIdentity)
+    {
+        vertex->texcoord[0] = texcoord[0];
+        vertex->texcoord[1] = texcoord[1];
+    }
+    else
+    {
+        const float *t = SW.stacks[2][SW.stackDepth[2]];
+        vertex->texcoord[0] = t[0]*texcoord[0] + t[4]*texcoord[1] + t[12];
+        vertex->texcoord[1] = t[1]*texcoord[0] + t[5]*texcoord[1] + t[13];
+    }
+
+    memcpy(vertex->color, color, 4*sizeof(float));
+
+    int required = (SW.primitiveMode == SW_LINES)? 2 : ((SW.primitiveMode == SW_TRIANGLES)? 3 : 4);
+
+    if (SW.vertexCount == required)
+    {
+        if (SW.primitiveMode == SW_LINES) swSubmitLine(&SW.vertices[0], &SW.vertices[1]);
+        else swSubmitPolygon(SW.vertices, required);
+
+        SW.vertexCount = 0;
+    }
+}
+
+// Get vertex distance to a frustum plane, inside if positive
+static float swClipDistance(const swVertex *vertex, int plane)
+{
+    const float *p = vertex->position;
+
+    switch (plane)
+    {
+        case 0: return p[3] + p[0];
+        case 1: return p[3] - p[0];
+        case 2: return p[3] + p[1];
+        case 3: return p[3] - p[1];
+        case 4: return p[3] + p[2];
+        default: return p[3] - p[2];
+    }
+}
+
+static void swLerpVertex(swVertex *result, const swVertex *a, const swVertex *b, float t)
+{
+    for (int i = 0; i < 4; i++) result->position[i] = a->position[i] + (b->position[i] - a->position[i])*t;
+    for (int i = 0; i < 2; i++) result->texcoord[i] = a->texcoord[i] + (b->texcoord[i] - a->texcoord[i])*t;
+    for (int i = 0; i < 4; i++) result->color[i] = a->color[i] + (b->color[i] - a->color[i])*t;
+}
+
+// Project clip space vertex to window coordinates
+static void swProjectVertex(swScreenVertex *result, const swVertex *vertex)
+{
+    float invW = 1.0f/vertex->position[3];
+
+    result->x = SW.viewport[0] + (vertex->position[0]*invW*0.5f + 0.5f)*SW.viewport[2];
+    result->y = SW.viewport[1] + (vertex->position[1]*invW*0.5f + 0.5f)*SW.viewport[3];
+    result->z = vertex->position[2]*invW*0.5f + 0.5f;
+    result->invW = invW;
+    memcpy(result->texcoord, vertex->texcoord, 2*sizeof(float));
+    memcpy(result->color, vertex->color, 4*sizeof(float));
+}
+
+// Clip, cull and set up a triangle or quad
+static void swSubmitPolygon(swVertex *polygon, int count)
+{
+    swVertex buffers[2][SW_MAX_CLIP_VERTICES];
+    swVertex *input = polygon;
+    int outside = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        for (int plane = 0; plane < 6; plane++)
+        {
+            if (swClipDistance(&polygon[i], plane) < 0.0f) outside |= (1 << plane);
+        }
+    }
+
+    // Clip against every frustum plane crossed by the polygon (Sutherland-Hodgman)
+    for (int plane = 0; (plane < 6) && (count > 0); plane++)
+    {
+        if (!(outside & (1 << plane))) continue;
+
+        swVertex *output = buffers[plane%2];
+        int outputCount = 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            const swVertex *current = &input[i];
+            const swVertex *next = &input[(i + 1)%count];
+            float currentDistance = swClipDistance(current, plane);
+            float nextDistance = swClipDistance(next, plane);
+
+            if (currentDistance >= 0.0f) output[outputCount++] = *current;
+            if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+            {
+                swLerpVertex(&output[outputCount++], current, next, currentDistance/(currentDistance - nextDistance));
+            }
+        }
+
+        input = output;
+        count = outputCount;
+    }
+
+    if (count < 3) return;
+
+    swScreenVertex screen[SW_MAX_CLIP_VERTICES];
+
+    for (int i = 0; i < count; i++)
+    {
+        if (input[i].position[3] <= 1e-20f) return;
+        swProjectVertex(&screen[i], &input[i]);
+    }
+
+    // Backface culling, counter-clockwise polygons have positive area
+    if (SW.cullFace)
+    {
+        float area = 0.0f;
+        for (int i = 0; i < count; i++)
+        {
+            const swScreenVertex *a = &screen[i];
+            const swScreenVertex *b = &screen[(i + 1)%count];
+            area += a->x*b->y - b->x*a->y;
+        }
+
+        bool front = (SW.frontFace == SW_CCW)? (area > 0.0f) : (area < 0.0f);
+
+        if ((SW.cullMode == SW_FRONT_AND_BACK) || ((SW.cullMode == SW_BACK) && !front) || ((SW.cullMode == SW_FRONT) && front)) return;
+    }
+
+    if (SW.polygonMode == SW_LINE)
+    {
+        for (int i = 0; i < count; i++) swSetupLine(&screen[i], &screen[(i + 1)%count]);
+    }
+    else
+    {
+        for (int i = 1; i < (count - 1); i++) swSetupTriangle(&screen[0], &screen[i], &screen[i + 1]);
+    }
+}
+
+// Clip and set up a line
+static void swSubmitLine(const swVertex *a, const swVertex *b)
+{
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+
+    for (int plane = 0; plane < 6; plane++)
+    {
+        float da = swClipDistance(a, plane);
+        float db = swClipDistance(b, plane);
+
+        if ((da < 0.0f) && (db < 0.0f)) return;
+        if (da < 0.0f) t0 = SW_MAX(t0, da/(da - db));
+        else if (db < 0.0f) t1 = SW_MIN(t1, da/(da - db));
+    }
+
+    if (t0 > t1) return;
+
+    swVertex clipped[2];
+    swLerpVertex(&clipped[0], a, b, t0);
+    swLerpVertex(&clipped[1], a, b, t1);
+
+    if ((clipped[0].position[3] <= 1e-20f) || (clipped[1].position[3] <= 1e-20f)) return;
+
+    swScreenVertex screen[2];
+    swProjectVertex(&screen[0], &clipped[0]);
+    swProjectVertex(&screen[1], &clipped[1]);
+
+    swSetupLine(&screen[0], &screen[1]);
+}
+
+// Get primitive pixel bounds clipped to viewport and scissor, false if empty
+static bool swGetBounds(int *bounds, float minX, float minY, float maxX, float maxY)
+{
+    // NOTE: Values clamped before conversion, vertex can be far away from the viewport (thick lines)
+    bounds[0] = SW_MAX(SW.clipBounds[0], (int)floorf(SW_MAX(minX, -1.0e6f)));
+    bounds[1] = SW_MAX(SW.clipBounds[1], (int)floorf(SW_MAX(minY, -1.0e6f)));
+    bounds[2] = SW_MIN(SW.clipBounds[2], (int)ceilf(SW_MIN(maxX, 1.0e6f)));
+    bounds[3] = SW_MIN(SW.clipBounds[3], (int)ceilf(SW_MIN(maxY, 1.0e6f)));
+
+    return ((bounds[0] <= bounds[2]) && (bounds[1] <= bounds[3]));
+}
+
+// Set up triangle edge functions and attributes planes
+static void swSetupTriangle(const swScreenVertex *a, const swScreenVertex *b, const swScreenVertex *c)
+{
+    float area = (b->x - a->x)*(c->y - a->y) - (c->x - a->x)*(b->y - a->y);
+    if (!(fabsf(area) > 0.0f)) return;      // Degenerated triangle (or NaN)
+
+    int bounds[4];
+    if (!swGetBounds(bounds, SW_MIN(a->x, SW_MIN(b->x, c->x)), SW_MIN(a->y, SW_MIN(b->y, c->y)),
+        SW_MAX(a->x, SW_MAX(b->x, c->x)), SW_MAX(a->y, SW_MAX(b->y, c->y)))) return;
+
+    swPrimitive *primitive = swPushPrimitive(SW_PRIMITIVE_TRIANGLE, bounds);
+    if (primitive == NULL) return;
+
+    swTriangleSetup *triangle = &primitive->setup.triangle;
+    const swScreenVertex *v[3] = { a, b, c };
+    float sign = (area > 0.0f)? 1.0f : -1.0f;
+
+    // Edge i goes from vertex (i + 1) to vertex (i + 2), opposite to vertex i
+    // NOTE: Edges shared by two triangles get exactly opposite functions, top-left rule
+    // assigns pixels centered on them to one triangle only (no gaps or double blending)
+    triangle->topLeft = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        const swScreenVertex *from = v[(i + 1)%3];
+        const swScreenVertex *to = v[(i + 2)%3];
+
+        triangle->edges[i][0] = (from->y - to->y)*sign;
+        triangle->edges[i][1] = (to->x - from->x)*sign;
+        triangle->edges[i][2] = (from->x*to->y - to->x*from->y)*sign;
+
+        if ((triangle->edges[i][0] > 0.0f) || ((triangle->edges[i][0] == 0.0f) && (triangle->edges[i][1] > 0.0f))) triangle->topLeft |= (1 << i);
+    }
+
+    // Attributes at every vertex, multiplied by 1/w for perspective correct interpolation
+    triangle->flags = 0;
+    if ((a->invW == b->invW) && (a->invW == c->invW)) triangle->flags |= SW_TRIANGLE_AFFINE;
+    if ((memcmp(a->color, b->color, 4*sizeof(float)) == 0) && (memcmp(a->color, c->color, 4*sizeof(float)) == 0))
+    {
+        triangle->flags |= SW_TRIANGLE_FLAT;
+        memcpy(triangle->color, a->color, 4*sizeof(float));
+        triangle->packedColor = swPackColor(a->color);
+    }
+
+    float values[3][SW_ATTRIB_COUNT];
+    for (int i = 0; i < 3; i++)
+    {
+        float invW = (triangle->flags & SW_TRIANGLE_AFFINE)? 1.0f : v[i]->invW;
+
+        values[i][SW_ATTRIB_Z] = v[i]->z;
+        values[i][SW_ATTRIB_INVW] = invW;
+        values[i][SW_ATTRIB_U] = v[i]->texcoord[0]*invW;
+        values[i][SW_ATTRIB_V] = v[i]->texcoord[1]*invW;
+        for (int j = 0; j < 4; j++) values[i][SW_ATTRIB_R + j] = v[i]->color[j]*invW;
+    }
+
+    float dx1 = b->x - a->x, dy1 = b->y - a->y;
+    float dx2 = c->x - a->x, dy2 = c->y - a->y;
+
+    triangle->x0 = a->x;
+    triangle->y0 = a->y;
+
+    for (int i = 0; i < SW_ATTRIB_COUNT; i++)
+    {
+        float d1 = values[1][i] - values[0][i];
+        float d2 = values[2][i] - values[0][i];
+
+        triangle->planes[i][0] = values[0][i];
+        triangle->planes[i][1] = (d1*dy2 - d2*dy1)/area;
+        triangle->planes[i][2] = (d2*dx1 - d1*dx2)/area;
+    }
+
+    // Texture filter: minification if triangle covers more texels than pixels
+    swTexture *texture = SW.states[primitive->state].texture;
+    if (texture != NULL)
+    {
+        float du1 = (b->texcoord[0] - a->texcoord[0])*texture->width, dv1 = (b->texcoord[1] - a->texcoord[1])*texture->height;
+        float du2 = (c->texcoord[0] - a->texcoord[0])*texture->width, dv2 = (c->texcoord[1] - a->texcoord[1])*texture->height;
+        float texelArea = fabsf(du1*dv2 - du2*dv1);
+        int filter = (texelArea > fabsf(area))? texture->minFilter : texture->magFilter;
+
+        if ((filter == SW_LINEAR) || (filter == SW_LINEAR_MIPMAP_NEAREST) || (filter == SW_LINEAR_MIPMAP_LINEAR)) triangle->flags |= SW_TRIANGLE_LINEAR;
+    }
+}
+
+// Set up a line, thick lines are drawn as two triangles
+static void swSetupLine(const swScreenVertex *a, const swScreenVertex *b)
+{
+    if (SW.lineWidth > 1.5f)
+    {
+        float dx = b->x - a->x;
+        float dy = b->y - a->y;
+        float length = sqrtf(dx*dx + dy*dy);
+        if (length == 0.0f) return;
+
+        float nx = -dy/length*SW.lineWidth*0.5f;
+        float ny = dx/length*SW.lineWidth*0.5f;
+
+        swScreenVertex quad[4] = { *a, *b, *b, *a };
+        quad[0].x += nx; quad[0].y += ny;
+        quad[1].x += nx; quad[1].y += ny;
+        quad[2].x -= nx; quad[2].y -= ny;
+        quad[3].x -= nx; quad[3].y -= ny;
+
+        swSetupTriangle(&quad[0], &quad[1], &quad[2]);
+        swSetupTriangle(&quad[0], &quad[2], &quad[3]);
+        return;
+    }
+
+    int bounds[4];
+    if (!swGetBounds(bounds, SW_MIN(a->x, b->x) - 1.0f, SW_MIN(a->y, b->y) - 1.0f, SW_MAX(a->x, b->x) + 1.0f, SW_MAX(a->y, b->y) + 1.0f)) return;
+
+    swPrimitive *primitive = swPushPrimitive(SW_PRIMITIVE_LINE, bounds);
+    if (primitive == NULL) return;
+
+    primitive->setup.line.v[0] = *a;
+    primitive->setup.line.v[1] = *b;
+
+    for (int i = 0; i < 2; i++)
+    {
+        swScreenVertex *v = &primitive->setup.line.v[i];
+        v->texcoord[0] *= v->invW;
+        v->texcoord[1] *= v->invW;
+        for (int j = 0; j < 4; j++) v->color[j] *= v->invW;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Definition - Rasterization
+//----------------------------------------------------------------------------------
+
+// Wrap texel coordinate
+static inline int swWrapCoord(int mode, int i, int size)
+{
+    switch (mode)
+    {
+        case SW_REPEAT:
+        {
+            i %= size;
+            if (i < 0) i += size;
+        } break;
+        case SW_MIRRORED_REPEAT:
+        {
+            int period = size*2;
+            i %= period;
+            if (i < 0) i += period;
+            if (i >= size) i = period - 1 - i;
+        } break;
+        default: i = (i < 0)? 0 : ((i >= size)? (size - 1) : i); break;
+    }
+
+    return i;
+}
+
+// Sample texture color (normalized) at texture coordinates
+static inline void swSampleTexture(const swTexture *texture, float u, float v, bool linear, float *texel)
+{
+    // NOTE: Coordinates clamped before conversion, wrapping result is the same for any representable texel
+    float x = u*texture->width;
+    float y = v*texture->height;
+    x = (x > 1.0e7f)? 1.0e7f : ((x < -1.0e7f)? -1.0e7f : ((x == x)? x : 0.0f));
+    y = (y > 1.0e7f)? 1.0e7f : ((y < -1.0e7f)? -1.0e7f : ((y == y)? y : 0.0f));
+
+    if (!linear)
+    {
+        int tx = swWrapCoord(texture->wrapS, (int)floorf(x), texture->width);
+        int ty = swWrapCoord(texture->wrapT, (int)floorf(y), texture->height);
+        const unsigned char *pixel = texture->pixels + (ty*texture->width + tx)*4;
+
+        for (int i = 0; i < 4; i++) texel[i] = pixel[i]/255.0f;
+    }
+    else
+    {
+        x -= 0.5f;
+        y -= 0.5f;
+
+        float fx = floorf(x);
+        float fy = floorf(y);
+        float ax = x - fx;
+        float ay = y - fy;
+        int x0 = swWrapCoord(texture->wrapS, (int)fx, texture->width);
+        int x1 = swWrapCoord(texture->wrapS, (int)fx + 1, texture->width);
+        int y0 = swWrapCoord(texture->wrapT, (int)fy, texture->height);
+        int y1 = swWrapCoord(texture->wrapT, (int)fy + 1, texture->height);
+
+        const unsigned char *p00 = texture->pixels + (y0*texture->width + x0)*4;
+        const unsigned char *p10 = texture->pixels + (y0*texture->width + x1)*4;
+        const unsigned char *p01 = texture->pixels + (y1*texture->width + x0)*4;
+        const unsigned char *p11 = texture->pixels + (y1*texture->width + x1)*4;
+
+        for (int i = 0; i < 4; i++)
+        {
+            float top = p00[i] + (p10[i] - p00[i])*ax;
+            float bottom = p01[i] + (p11[i] - p01[i])*ax;
+            texel[i] = (top + (bottom - top)*ay)/255.0f;
+        }
+    }
+}
+
+static inline bool swDepthTest(int func, float z, float depth)
+{
+    switch (func)
+    {
+        case SW_NEVER: return false;
+        case SW_LESS: return (z < depth);
+        case SW_EQUAL: return (z == depth);
+        case SW_LEQUAL: return (z <= depth);
+        case SW_GREATER: return (z > depth);
+        case SW_NOTEQUAL: return (z != depth);
+        case SW_GEQUAL: return (z >= depth);
+        default: return true;
+    }
+}
+
+// Get blend factor for every channel
+static inline void swGetBlendFactor(int factor, const float *src, const float *dst, float *result)
+{
+    switch (factor)
+    {
+        case SW_ZERO: result[0] = result[1] = result[2] = result[3] = 0.0f; break;
+        case SW_SRC_COLOR: memcpy(result, src, 4*sizeof(float)); break;
+        case SW_ONE_MINUS_SRC_COLOR: for (int i = 0; i < 4; i++) result[i] = 1.0f - src[i]; break;
+        case SW_SRC_ALPHA: result[0] = result[1] = result[2] = result[3] = src[3]; break;
+        case SW_ONE_MINUS_SRC_ALPHA: result[0] = result[1] = result[2] = result[3] = 1.0f - src[3]; break;
+        case SW_DST_ALPHA: result[0] = result[1] = result[2] = result[3] = dst[3]; break;
+        case SW_ONE_MINUS_DST_ALPHA: result[0] = result[1] = result[2] = result[3] = 1.0f - dst[3]; break;
+        case SW_DST_COLOR: memcpy(result, dst, 4*sizeof(float)); break;
+        case SW_ONE_MINUS_DST_COLOR: for (int i = 0; i < 4; i++) result[i] = 1.0f - dst[i]; break;
+        case SW_SRC_ALPHA_SATURATE:
+        {
+            result[0] = result[1] = result[2] = SW_MIN(src[3], 1.0f - dst[3]);
+            result[3] = 1.0f;
+        } break;
+        default: result[0] = result[1] = result[2] = result[3] = 1.0f; break;
+    }
+}
+
+// Write color to pixel, blended if required
+static inline void swWritePixel(const swRenderState *state, unsigned char *pixel, float *color)
+{
+    for (int i = 0; i < 4; i++) color[i] = (color[i] < 0.0f)? 0.0f : ((color[i] > 1.0f)? 1.0f : color[i]);
+
+    if (state->blend)
+    {
+        float dst[4] = { pixel[0]/255.0f, pixel[1]/255.0f, pixel[2]/255.0f, pixel[3]/255.0f };
+        float srcFactor[4], dstFactor[4];
+
+        swGetBlendFactor(state->srcFactor, color, dst, srcFactor);
+        swGetBlendFactor(state->dstFactor, color, dst, dstFactor);
+
+        for (int i = 0; i < 4; i++)
+        {
+            float value = color[i]*srcFactor[i] + dst[i]*dstFactor[i];
+            color[i] = (value > 1.0f)? 1.0f : value;
+        }
+    }
+
+    for (int i = 0; i < 4; i++) pixel[i] = (unsigned char)(color[i]*255.0f + 0.5f);
+}
+
+// Fill pixels with a color
+static void swFillColor(unsigned int *pixels, int count, unsigned int color)
+{
+#if defined(RLSW_SSE2)
+    __m128i value = _mm_set1_epi32((int)color);
+    for (; count >= 4; count -= 4, pixels += 4) _mm_storeu_si128((__m128i *)pixels, value);
+#endif
+    for (; count > 0; count--, pixels++) *pixels = color;
+}
+
+// Blend pixels with a color using its alpha (SW_SRC_ALPHA, SW_ONE_MINUS_SRC_ALPHA)
+// NOTE: Integer blending, result = (src*alpha + dst*(255 - alpha))/255 rounded, same for SSE2 and scalar
+static void swBlendColorAlpha(unsigned int *pixels, int count, const unsigned char *color)
+{
+    int alpha = color[3];
+    int invAlpha = 255 - alpha;
+
+#if defined(RLSW_SSE2)
+    __m128i zero = _mm_setzero_si128();
+    __m128i half = _mm_set1_epi16(128);
+    __m128i inv = _mm_set1_epi16((short)invAlpha);
+    __m128i src = _mm_setr_epi16((short)(color[0]*alpha), (short)(color[1]*alpha), (short)(color[2]*alpha), (short)(color[3]*alpha),
+                                 (short)(color[0]*alpha), (short)(color[1]*alpha), (short)(color[2]*alpha), (short)(color[3]*alpha));
+
+    for (; count >= 4; count -= 4, pixels += 4)
+    {
+        __m128i dst = _mm_loadu_si128((const __m128i *)pixels);
+        __m128i lo = _mm_unpacklo_epi8(dst, zero);      // Two pixels, 16bit per channel
+        __m128i hi = _mm_unpackhi_epi8(dst, zero);
+
+        lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, inv), src), half);
+        hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, inv), src), half);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+        _mm_storeu_si128((__m128i *)pixels, _mm_packus_epi16(lo, hi));
+    }
+#endif
+
+    for (; count > 0; count--, pixels++)
+    {
+        unsigned char *pixel = (unsigned char *)pixels;
+
+        for (int i = 0; i < 4; i++)
+        {
+            unsigned int value = color[i]*alpha + pixel[i]*invAlpha + 128;
+            pixel[i] = (unsigned char)((value + (value >> 8)) >> 8);
+        }
+    }
+}
+
+// Shade one pixel: depth test, texturing and blending
+// NOTE: Color is not multiplied by 1/w, w is provided to get final attributes
+static inline void swShadePixel(const swRenderState *state, unsigned char *pixel, float *depth, float z, float w,
+                                const float *color, float u, float v, bool linear)
+{
+    if (state->depthTest && !swDepthTest(state->depthFunc, z, *depth)) return;
+
+    float result[4] = { color[0]*w, color[1]*w, color[2]*w, color[3]*w };
+
+    if (state->texture != NULL)
+    {
+        float texel[4];
+        swSampleTexture(state->texture, u*w, v*w, linear, texel);
+        for (int i = 0; i < 4; i++) result[i] *= texel[i];
+    }
+
+    swWritePixel(state, pixel, result);
+
+    if (state->depthTest && state->depthMask) *depth = z;
+}
+
+// Draw flat colored untextured span, SSE2 used for plain fills and alpha blending
+static void swDrawFlatSpan(const swRenderState *state, unsigned int *pixels, int count, const float *color, unsigned int packed)
+{
+    unsigned char bytes[4];
+    memcpy(bytes, &packed, 4);
+
+    if (!state->blend || ((state->srcFactor == SW_ONE) && (state->dstFactor == SW_ZERO))) swFillColor(pixels, count, packed);
+    else if ((state->srcFactor == SW_SRC_ALPHA) && (state->dstFactor == SW_ONE_MINUS_SRC_ALPHA))
+    {
+        if (bytes[3] == 255) swFillColor(pixels, count, packed);
+        else if (bytes[3] > 0) swBlendColorAlpha(pixels, count, bytes);
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
+        {
+            float result[4] = { color[0], color[1], color[2], color[3] };
+            swWritePixel(state, (unsigned char *)&pixels[i], result);
+        }
+    }
+}
+
+// Check pixel center inside triangle (top-left rule for pixels on edges)
+static inline bool swInsideTriangle(const swTriangleSetup *triangle, float x, float y)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        float value = triangle->edges[i][0]*x + triangle->edges[i][1]*y + triangle->edges[i][2];
+        if ((value < 0.0f) || ((value == 0.0f) && !(triangle->topLeft & (1 << i)))) return false;
+    }
+
+    return true;
+}
+
+// Rasterize triangle pixels inside bounds, one horizontal span per row
+static void swRasterTriangle(const swPrimitive *primitive, const swRenderState *state, const int *bounds)
+{
+    const swTriangleSetup *triangle = &primitive->setup.triangle;
+    bool affine = (triangle->flags & SW_TRIANGLE_AFFINE);
+    bool linear = (triangle->flags & SW_TRIANGLE_LINEAR);
+    bool flat = (triangle->flags & SW_TRIANGLE_FLAT);
+
+    for (int y = bounds[1]; y <= bounds[3]; y++)
+    {
+        float py = y + 0.5f;
+        int startX = bounds[0];
+        int endX = bounds[2];
+
+        // Span candidates from edge functions, one pixel wider, exact test on span ends
+        for (int i = 0; (i < 3) && (startX <= endX); i++)
+        {
+            float a = triangle->edges[i][0];
+            float rest = triangle->edges[i][1]*py + triangle->edges[i][2];
+
+            if (a != 0.0f)
+            {
+                float x = -rest/a - 0.5f;
+                x = (x < bounds[0] - 2.0f)? (bounds[0] - 2.0f) : ((x > bounds[2] + 2.0f)? (bounds[2] + 2.0f) : x);
+
+                if (a > 0.0f) startX = SW_MAX(startX, SW_CEIL(x) - 1);
+                else endX = SW_MIN(endX, SW_FLOOR(x) + 1);
+            }
+            else if ((rest < 0.0f) || ((rest == 0.0f) && !(triangle->topLeft & (1 << i)))) endX = startX - 1;
+        }
+
+        while ((startX <= endX) && !swInsideTriangle(triangle, startX + 0.5f, py)) startX++;
+        while ((endX >= startX) && !swInsideTriangle(triangle, endX + 0.5f, py)) endX--;
+
+        if (startX > endX) continue;
+
+        unsigned int *pixels = SW.colorBuffer + y*SW.width;
+        float *depths = SW.depthBuffer + y*SW.width;
+
+        if (flat && (state->texture == NULL) && !state->depthTest)
+        {
+            swDrawFlatSpan(state, pixels + startX, endX - startX + 1, triangle->color, triangle->packedColor);
+            continue;
+        }
+
+        float dx = startX + 0.5f - triangle->x0;
+        float dy = py - triangle->y0;
+        float values[SW_ATTRIB_COUNT];
+        for (int i = 0; i < SW_ATTRIB_COUNT; i++) values[i] = triangle->planes[i][0] + triangle->planes[i][1]*dx + triangle->planes[i][2]*dy;
+
+        for (int x = startX; x <= endX; x++)
+        {
+            float w = affine? 1.0f : 1.0f/values[SW_ATTRIB_INVW];
+            const float *color = &values[SW_ATTRIB_R];
+            float flatColor[4];
+
+            if (flat)
+            {
+                for (int i = 0; i < 4; i++) flatColor[i] = triangle->color[i]/w;
+                color = flatColor;
+            }
+
+            swShadePixel(state, (unsigned char *)&pixels[x], &depths[x], values[SW_ATTRIB_Z], w, color, values[SW_ATTRIB_U], values[SW_ATTRIB_V], linear);
+
+            for (int i = 0; i < SW_ATTRIB_COUNT; i++) values[i] += triangle->planes[i][1];
+        }
+    }
+}
+
+// Rasterize line pixels inside bounds, one pixel per column (or row) crossed
+static void swRasterLine(const swPrimitive *primitive, const swRenderState *state, const int *bounds)
+{
+    const swScreenVertex *a = &primitive->setup.line.v[0];
+    const swScreenVertex *b = &primitive->setup.line.v[1];
+    float dx = b->x - a->x;
+    float dy = b->y - a->y;
+    bool major = (fabsf(dx) >= fabsf(dy));      // Line advances along x
+    float delta = major? dx : dy;
+
+    if (delta == 0.0f) return;
+
+    // Pixel centers in [start, end) along major axis, shared end points are drawn once
+    float start = major? SW_MIN(a->x, b->x) : SW_MIN(a->y, b->y);
+    float end = major? SW_MAX(a->x, b->x) : SW_MAX(a->y, b->y);
+    int first = SW_MAX((int)ceilf(start - 0.5f), major? bounds[0] : bounds[1]);
+    int last = SW_MIN((int)ceilf(end - 0.5f) - 1, major? bounds[2] : bounds[3]);
+
+    for (int i = first; i <= last; i++)
+    {
+        float t = ((i + 0.5f) - (major? a->x : a->y))/delta;
+        float minor = major? (a->y + t*dy) : (a->x + t*dx);
+        int x = major? i : (int)floorf(minor);
+        int y = major? (int)floorf(minor) : i;
+
+        if ((x < bounds[0]) || (x > bounds[2]) || (y < bounds[1]) || (y > bounds[3])) continue;
+
+        float invW = a->invW + (b->invW - a->invW)*t;
+        float color[4];
+        for (int c = 0; c < 4; c++) color[c] = a->color[c] + (b->color[c] - a->color[c])*t;
+        float u = a->texcoord[0] + (b->texcoord[0] - a->texcoord[0])*t;
+        float v = a->texcoord[1] + (b->texcoord[1] - a->texcoord[1])*t;
+
+        swShadePixel(state, (unsigned char *)&SW.colorBuffer[y*SW.width + x], &SW.depthBuffer[y*SW.width + x],
+                     a->z + (b->z - a->z)*t, 1.0f/invW, color, u, v, false);
+    }
+}
+
+// Rasterize all primitives binned in a tile, in submission order
+static void swRasterizeTile(int tile)
+{
+    int tileX = (tile%SW.tilesX)*RLSW_TILE_SIZE;
+    int tileY = (tile/SW.tilesX)*RLSW_TILE_SIZE;
+    const swTileBin *bin = &SW.bins[tile];
+
+    for (int i = 0; i < bin->count; i++)
+    {
+        const swPrimitive *primitive = &SW.primitives[bin->items[i]];
+        const swRenderState *state = &SW.states[primitive->state];
+        int bounds[4] = {
+            SW_MAX(primitive->bounds[0], tileX),
+            SW_MAX(primitive->bounds[1], tileY),
+            SW_MIN(primitive->bounds[2], tileX + RLSW_TILE_SIZE - 1),
+            SW_MIN(primitive->bounds[3], tileY + RLSW_TILE_SIZE - 1)
+        };
+
+        switch (primitive->type)
+        {
+            case SW_PRIMITIVE_CLEAR:
+            {
+                const swClearSetup *clear = &primitive->setup.clear;
+                int count = bounds[2] - bounds[0] + 1;
+
+                for (int y = bounds[1]; y <= bounds[3]; y++)
+                {
+                    if (clear->mask & SW_COLOR_BUFFER_BIT) swFillColor(SW.colorBuffer + y*SW.width + bounds[0], count, clear->color);
+                    if (clear->mask & SW_DEPTH_BUFFER_BIT)
+                    {
+                        float *depths = SW.depthBuffer + y*SW.width + bounds[0];
+                        for (int x = 0; x < count; x++) depths[x] = clear->depth;
+                    }
+                }
+            } break;
+            case SW_PRIMITIVE_LINE: swRasterLine(primitive, state, bounds); break;
+            case SW_PRIMITIVE_TRIANGLE: swRasterTriangle(primitive, state, bounds); break;
+            default: break;
+        }
+    }
+}
+
+// Rasterize tiles until none left (called by every thread)
+static void swRasterizeTiles(void)
+{
+    int tileCount = SW.tilesX*SW.tilesY;
+
+    while (true)
+    {
+        int tile = 0;
+
+        if (SW.workerCount > 0)
+        {
+            swMutexLock(&SW.lock);
+            tile = SW.nextTile++;
+            swMutexUnlock(&SW.lock);
+        }
+        else tile = SW.nextTile++;
+
+        if (tile >= tileCount) break;
+        if (SW.bins[tile].count > 0) swRasterizeTile(tile);
+    }
+}
+
+#endif  // RLSW_IMPLEMENTATION
@@ -56,8 +56,9 @@
 
 #include "rlgl.h"       // OpenGL abstraction layer to OpenGL 1.1, 2.1, 3.3+ or ES2
 
-#include <math.h>       // Required for: sinf(), asinf(), cosf(), acosf(), sqrtf(), fabsf()
+#include <math.h>       // Required for: sinf(), asinf(), cosf(), acosf(), sqrtf(), fabsf(), roundf()
 #include <float.h>      // Required for: FLT_EPSILON
+#include <stdlib.h>     // Required for: RL_REALLOC(), RL_FREE(), NULL
 
 //----------------------------------------------------------------------------------
 // Defines and Macros
@@ -70,12 +71,23 @@
 #ifndef BEZIER_LINE_DIVISIONS
     #define BEZIER_LINE_DIVISIONS       24      // Bezier line divisions
 #endif
+#ifndef MAX_CIRCLE_TABLES
+    #define MAX_CIRCLE_TABLES           16      // Maximum number of cached unit circle tables (one per segment count)
+#endif
+#ifndef MAX_CIRCLE_TABLE_SEGMENTS
+    #define MAX_CIRCLE_TABLE_SEGMENTS   128     // Maximum number of segments of a cached unit circle table
+#endif
 
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-// Not here...
+// Unit circle points for a number of segments, (sinf, cosf) of every segment angle
+// NOTE: Points go around the circle twice, so any arc up to a full turn can be read from any start point
+typedef struct CircleTable {
+    int segments;                                       // Segments in a full turn, 0 if table is not used
+    Vector2 points[2*MAX_CIRCLE_TABLE_SEGMENTS + 1];    // Unit circle points
+} CircleTable;
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
@@ -83,10 +95,53 @@
 Texture2D texShapes = { 1, 1, 1, 1, 7 };                // Texture used on shapes drawing (usually a white pixel)
 Rectangle texShapesRec = { 0.0f, 0.0f, 1.0f, 1.0f };    // Texture source rectangle used on shapes drawing
 
+static Shader circleShader = { 0 };                     // Shader used on batched circles drawing (signed distance)
+static bool circleShaderLoaded = false;                 // Circle shader is loaded on first use
+
+static CircleTable circleTables[MAX_CIRCLE_TABLES] = { 0 };     // Unit circle tables cache, shared by all shapes
+static int circleTableNext = 0;                         // Next table to replace when cache is full
+static Vector2 *arcPoints = NULL;                       // Points of arcs that can not be read from a table
+static int arcPointsCapacity = 0;                       // Capacity of arc points buffer
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+// Circle fragment shader, texture coordinates go from -1.0 to 1.0 across the quad,
+// so the distance to its center is 1.0 at the circle border, antialiased over one pixel
+static const char *circleFShaderCode =
+#if defined(GRAPHICS_API_OPENGL_21)
+    "#version 120                       \n"
+    "varying vec2 fragTexCoord;         \n"
+    "varying vec4 fragColor;            \n"
+#elif defined(GRAPHICS_API_OPENGL_33)
+    "#version 330                       \n"
+    "in vec2 fragTexCoord;              \n"
+    "in vec4 fragColor;                 \n"
+    "out vec4 finalColor;               \n"
+#endif
+#if defined(GRAPHICS_API_OPENGL_ES2)
+    "#version 100                       \n"
+    "#extension GL_OES_standard_derivatives : enable \n"
+    "precision mediump float;           \n"
+    "varying vec2 fragTexCoord;         \n"
+    "varying vec4 fragColor;            \n"
+#endif
+    "void main()                        \n"
+    "{                                  \n"
+    "    float distance = length(fragTexCoord); \n"
+    "    float edge = fwidth(distance);     \n"
+    "    float alpha = 1.0 - smoothstep(1.0 - edge, 1.0, distance); \n"
+#if defined(GRAPHICS_API_OPENGL_33) && !defined(GRAPHICS_API_OPENGL_21)
+    "    finalColor = vec4(fragColor.rgb, fragColor.a*alpha); \n"
+#else
+    "    gl_FragColor = vec4(fragColor.rgb, fragColor.a*alpha); \n"
+#endif
+    "}                                  \n";
+#endif
+
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
 //----------------------------------------------------------------------------------
 static float EaseCubicInOut(float t, float b, float c, float d);    // Cubic easing
+static const Vector2 *GetCircleArc(float startAngle, float stepLength, int segments);  // Get unit circle points of an arc
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition
@@ -284,7 +339,8 @@ void DrawCircleSector(Vector2 center, float radius, float startAngle, float endA
     }
 
     float stepLength = (endAngle - startAngle)/(float)segments;
-    float angle = startAngle;
+    const Vector2 *arc = GetCircleArc(startAngle, stepLength, segments);
+    int point = 0;      // Current point on the arc
 
 #if defined(SUPPORT_QUADS_DRAW_MODE)
     rlCheckRenderBatchLimit(4*segments/2);
@@ -301,15 +357,15 @@ void DrawCircleSector(Vector2 center, float radius, float startAngle, float endA
             rlVertex2f(center.x, center.y);
 
             rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*radius, center.y + cosf(DEG2RAD*angle)*radius);
+            rlVertex2f(center.x + arc[point].x*radius, center.y + arc[point].y*radius);
 
             rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*radius, center.y + cosf(DEG2RAD*(angle + stepLength))*radius);
+            rlVertex2f(center.x + arc[point + 1].x*radius, center.y + arc[point + 1].y*radius);
 
             rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength*2))*radius, center.y + cosf(DEG2RAD*(angle + stepLength*2))*radius);
+            rlVertex2f(center.x + arc[point + 2].x*radius, center.y + arc[point + 2].y*radius);
 
-            angle += (stepLength*2);
+            point += 2;
         }
 
         // NOTE: In case number of segments is odd, we add one last piece to the cake
@@ -321,10 +377,10 @@ void DrawCircleSector(Vector2 center, float radius, float startAngle, float endA
             rlVertex2f(center.x, center.y);
 
             rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*radius, center.y + cosf(DEG2RAD*angle)*radius);
+            rlVertex2f(center.x + arc[point].x*radius, center.y + arc[point].y*radius);
 
             rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*radius, center.y + cosf(DEG2RAD*(angle + stepLength))*radius);
+            rlVertex2f(center.x + arc[point + 1].x*radius, center.y + arc[point + 1].y*radius);
 
             rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
             rlVertex2f(center.x, center.y);
@@ -341,10 +397,10 @@ void DrawCircleSector(Vector2 center, float radius, float startAngle, float endA
             rlColor4ub(color.r, color.g, color.b, color.a);
 
             rlVertex2f(center.x, center.y);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*radius, center.y + cosf(DEG2RAD*angle)*radius);
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*radius, center.y + cosf(DEG2RAD*(angle + stepLength))*radius);
+            rlVertex2f(center.x + arc[point].x*radius, center.y + arc[point].y*radius);
+            rlVertex2f(center.x + arc[point + 1].x*radius, center.y + arc[point + 1].y*radius);
 
-            angle += stepLength;
+            point++;
         }
     rlEnd();
 #endif
@@ -376,7 +432,8 @@ void DrawCircleSectorLines(Vector2 center, float radius, float startAngle, float
     }
 
     float stepLength = (endAngle - startAngle)/(float)segments;
-    float angle = startAngle;
+    const Vector2 *arc = GetCircleArc(startAngle, stepLength, segments);
+    int point = 0;      // Current point on the arc
 
     // Hide the cap lines when the circle is full
     bool showCapLines = true;
@@ -390,24 +447,24 @@ void DrawCircleSectorLines(Vector2 center, float radius, float startAngle, float
         {
             rlColor4ub(color.r, color.g, color.b, color.a);
             rlVertex2f(center.x, center.y);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*radius, center.y + cosf(DEG2RAD*angle)*radius);
+            rlVertex2f(center.x + arc[point].x*radius, center.y + arc[point].y*radius);
         }
 
         for (int i = 0; i < segments; i++)
         {
             rlColor4ub(color.r, color.g, color.b, color.a);
 
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*radius, center.y + cosf(DEG2RAD*angle)*radius);
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*radius, center.y + cosf(DEG2RAD*(angle + stepLength))*radius);
+            rlVertex2f(center.x + arc[point].x*radius, center.y + arc[point].y*radius);
+            rlVertex2f(center.x + arc[point + 1].x*radius, center.y + arc[point + 1].y*radius);
 
-            angle += stepLength;
+            point++;
         }
 
         if (showCapLines)
         {
             rlColor4ub(color.r, color.g, color.b, color.a);
             rlVertex2f(center.x, center.y);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*radius, center.y + cosf(DEG2RAD*angle)*radius);
+            rlVertex2f(center.x + arc[point].x*radius, center.y + arc[point].y*radius);
         }
     rlEnd();
 }
@@ -416,17 +473,19 @@ void DrawCircleSectorLines(Vector2 center, float radius, float startAngle, float
 // NOTE: Gradient goes from center (color1) to border (color2)
 void DrawCircleGradient(int centerX, int centerY, float radius, Color color1, Color color2)
 {
+    const Vector2 *arc = GetCircleArc(0.0f, 10.0f, 36);
+
     rlCheckRenderBatchLimit(3*36);
 
     rlBegin(RL_TRIANGLES);
-        for (int i = 0; i < 360; i += 10)
+        for (int i = 0; i < 36; i++)
         {
             rlColor4ub(color1.r, color1.g, color1.b, color1.a);
             rlVertex2f((float)centerX, (float)centerY);
             rlColor4ub(color2.r, color2.g, color2.b, color2.a);
-            rlVertex2f((float)centerX + sinf(DEG2RAD*i)*radius, (float)centerY + cosf(DEG2RAD*i)*radius);
+            rlVertex2f((float)centerX + arc[i].x*radius, (float)centerY + arc[i].y*radius);
             rlColor4ub(color2.r, color2.g, color2.b, color2.a);
-            rlVertex2f((float)centerX + sinf(DEG2RAD*(i + 10))*radius, (float)centerY + cosf(DEG2RAD*(i + 10))*radius);
+            rlVertex2f((float)centerX + arc[i + 1].x*radius, (float)centerY + arc[i + 1].y*radius);
         }
     rlEnd();
 }
@@ -438,19 +497,86 @@ void DrawCircleV(Vector2 center, float radius, Color color)
     DrawCircleSector(center, radius, 0, 360, 36, color);
 }
 
+// Draw multiple color-filled circles
+// NOTE: Every circle is a single quad, its shape and antialiased border are computed in a
+// fragment shader from the distance to its center. Shader is changed, so current batch is drawn
+// before and after, and the default shader is set back. Falls back to DrawCircleV() on OpenGL 1.1
+void DrawCircleBatch(Vector2 *centers, float *radius, Color *colors, int count)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!circleShaderLoaded)
+    {
+        circleShader = LoadShaderFromMemory(NULL, circleFShaderCode);
+        circleShaderLoaded = true;
+    }
+
+    if ((circleShader.id > 0) && (circleShader.id != rlGetShaderIdDefault()))
+    {
+        rlSetShader(circleShader.id, circleShader.locs);
+
+        for (int i = 0; i < count; i++)
+        {
+            float x = centers[i].x;
+            float y = centers[i].y;
+            float r = radius[i];
+
+            if (r <= 0.0f) continue;
+
+            rlCheckRenderBatchLimit(4);
+
+            rlBegin(RL_QUADS);
+                rlColor4ub(colors[i].r, colors[i].g, colors[i].b, colors[i].a);
+
+                rlTexCoord2f(-1.0f, -1.0f);
+                rlVertex2f(x - r, y - r);
+
+                rlTexCoord2f(-1.0f, 1.0f);
+                rlVertex2f(x - r, y + r);
+
+                rlTexCoord2f(1.0f, 1.0f);
+                rlVertex2f(x + r, y + r);
+
+                rlTexCoord2f(1.0f, -1.0f);
+                rlVertex2f(x + r, y - r);
+            rlEnd();
+        }
+
+        rlSetShader(rlGetShaderIdDefault(), rlGetShaderLocsDefault());
+        return;
+    }
+#endif
+
+    for (int i = 0; i < count; i++) DrawCircleV(centers[i], radius[i], colors[i]);
+}
+
+// Unload shapes default data: circle shader (if it was ever loaded) and tessellation buffers
+void UnloadShapesDefault(void)
+{
+    if (circleShaderLoaded) UnloadShader(circleShader);
+
+    circleShader = (Shader){ 0 };
+    circleShaderLoaded = false;
+
+    RL_FREE(arcPoints);
+    arcPoints = NULL;
+    arcPointsCapacity = 0;
+}
+
 // Draw circle outline
 void DrawCircleLines(int centerX, int centerY, float radius, Color color)
 {
+    const Vector2 *arc = GetCircleArc(0.0f, 10.0f, 36);
+
     rlCheckRenderBatchLimit(2*36);
 
     rlBegin(RL_LINES);
         rlColor4ub(color.r, color.g, color.b, color.a);
 
-        // NOTE: Circle outline is drawn pixel by pixel every degree (0 to 360)
-        for (int i = 0; i < 360; i += 10)
+        // NOTE: Circle outline is drawn every 10 degrees (0 to 360)
+        for (int i = 0; i < 36; i++)
         {
-            rlVertex2f(centerX + sinf(DEG2RAD*i)*radius, centerY + cosf(DEG2RAD*i)*radius);
-            rlVertex2f(centerX + sinf(DEG2RAD*(i + 10))*radius, centerY + cosf(DEG2RAD*(i + 10))*radius);
+            rlVertex2f(centerX + arc[i].x*radius, centerY + arc[i].y*radius);
+            rlVertex2f(centerX + arc[i + 1].x*radius, centerY + arc[i + 1].y*radius);
         }
     rlEnd();
 }
@@ -458,15 +584,17 @@ void DrawCircleLines(int centerX, int centerY, float radius, Color color)
 // Draw ellipse
 void DrawEllipse(int centerX, int centerY, float radiusH, float radiusV, Color color)
 {
+    const Vector2 *arc = GetCircleArc(0.0f, 10.0f, 36);
+
     rlCheckRenderBatchLimit(3*36);
 
     rlBegin(RL_TRIANGLES);
-        for (int i = 0; i < 360; i += 10)
+        for (int i = 0; i < 36; i++)
         {
             rlColor4ub(color.r, color.g, color.b, color.a);
             rlVertex2f((float)centerX, (float)centerY);
-            rlVertex2f((float)centerX + sinf(DEG2RAD*i)*radiusH, (float)centerY + cosf(DEG2RAD*i)*radiusV);
-            rlVertex2f((float)centerX + sinf(DEG2RAD*(i + 10))*radiusH, (float)centerY + cosf(DEG2RAD*(i + 10))*radiusV);
+            rlVertex2f((float)centerX + arc[i].x*radiusH, (float)centerY + arc[i].y*radiusV);
+            rlVertex2f((float)centerX + arc[i + 1].x*radiusH, (float)centerY + arc[i + 1].y*radiusV);
         }
     rlEnd();
 }
@@ -474,14 +602,16 @@ void DrawEllipse(int centerX, int centerY, float radiusH, float radiusV, Color c
 // Draw ellipse outline
 void DrawEllipseLines(int centerX, int centerY, float radiusH, float radiusV, Color color)
 {
+    const Vector2 *arc = GetCircleArc(0.0f, 10.0f, 36);
+
     rlCheckRenderBatchLimit(2*36);
 
     rlBegin(RL_LINES);
-        for (int i = 0; i < 360; i += 10)
+        for (int i = 0; i < 36; i++)
         {
             rlColor4ub(color.r, color.g, color.b, color.a);
-            rlVertex2f(centerX + sinf(DEG2RAD*i)*radiusH, centerY + cosf(DEG2RAD*i)*radiusV);
-            rlVertex2f(centerX + sinf(DEG2RAD*(i + 10))*radiusH, centerY + cosf(DEG2RAD*(i + 10))*radiusV);
+            rlVertex2f(centerX + arc[i].x*radiusH, centerY + arc[i].y*radiusV);
+            rlVertex2f(centerX + arc[i + 1].x*radiusH, centerY + arc[i + 1].y*radiusV);
         }
     rlEnd();
 }
@@ -529,7 +659,8 @@ void DrawRing(Vector2 center, float innerRadius, float outerRadius, float startA
     }
 
     float stepLength = (endAngle - startAngle)/(float)segments;
-    float angle = startAngle;
+    const Vector2 *arc = GetCircleArc(startAngle, stepLength, segments);
+    int point = 0;      // Current point on the arc
 
 #if defined(SUPPORT_QUADS_DRAW_MODE)
     rlCheckRenderBatchLimit(4*segments);
@@ -542,18 +673,18 @@ void DrawRing(Vector2 center, float innerRadius, float outerRadius, float startA
             rlColor4ub(color.r, color.g, color.b, color.a);
 
             rlTexCoord2f(texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*innerRadius, center.y + cosf(DEG2RAD*angle)*innerRadius);
+            rlVertex2f(center.x + arc[point].x*innerRadius, center.y + arc[point].y*innerRadius);
 
             rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*outerRadius, center.y + cosf(DEG2RAD*angle)*outerRadius);
+            rlVertex2f(center.x + arc[point].x*outerRadius, center.y + arc[point].y*outerRadius);
 
             rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*outerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*outerRadius);
+            rlVertex2f(center.x + arc[point + 1].x*outerRadius, center.y + arc[point + 1].y*outerRadius);
 
             rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*innerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*innerRadius);
+            rlVertex2f(center.x + arc[point + 1].x*innerRadius, center.y + arc[point + 1].y*innerRadius);
 
-            angle += stepLength;
+            point++;
         }
     rlEnd();
 
@@ -566,15 +697,15 @@ void DrawRing(Vector2 center, float innerRadius, float outerRadius, float startA
         {
             rlColor4ub(color.r, color.g, color.b, color.a);
 
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*innerRadius, center.y + cosf(DEG2RAD*angle)*innerRadius);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*outerRadius, center.y + cosf(DEG2RAD*angle)*outerRadius);
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*innerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*innerRadius);
+            rlVertex2f(center.x + arc[point].x*innerRadius, center.y + arc[point].y*innerRadius);
+            rlVertex2f(center.x + arc[point].x*outerRadius, center.y + arc[point].y*outerRadius);
+            rlVertex2f(center.x + arc[point + 1].x*innerRadius, center.y + arc[point + 1].y*innerRadius);
 
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*innerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*innerRadius);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*outerRadius, center.y + cosf(DEG2RAD*angle)*outerRadius);
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*outerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*outerRadius);
+            rlVertex2f(center.x + arc[point + 1].x*innerRadius, center.y + arc[point + 1].y*innerRadius);
+            rlVertex2f(center.x + arc[point].x*outerRadius, center.y + arc[point].y*outerRadius);
+            rlVertex2f(center.x + arc[point + 1].x*outerRadius, center.y + arc[point + 1].y*outerRadius);
 
-            angle += stepLength;
+            point++;
         }
     rlEnd();
 #endif
@@ -622,7 +753,8 @@ void DrawRingLines(Vector2 center, float innerRadius, float outerRadius, float s
     }
 
     float stepLength = (endAngle - startAngle)/(float)segments;
-    float angle = startAngle;
+    const Vector2 *arc = GetCircleArc(startAngle, stepLength, segments);
+    int point = 0;      // Current point on the arc
 
     bool showCapLines = true;
     int limit = 4*(segments + 1);
@@ -634,28 +766,28 @@ void DrawRingLines(Vector2 center, float innerRadius, float outerRadius, float s
         if (showCapLines)
         {
             rlColor4ub(color.r, color.g, color.b, color.a);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*outerRadius, center.y + cosf(DEG2RAD*angle)*outerRadius);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*innerRadius, center.y + cosf(DEG2RAD*angle)*innerRadius);
+            rlVertex2f(center.x + arc[point].x*outerRadius, center.y + arc[point].y*outerRadius);
+            rlVertex2f(center.x + arc[point].x*innerRadius, center.y + arc[point].y*innerRadius);
         }
 
         for (int i = 0; i < segments; i++)
         {
             rlColor4ub(color.r, color.g, color.b, color.a);
 
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*outerRadius, center.y + cosf(DEG2RAD*angle)*outerRadius);
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*outerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*outerRadius);
+            rlVertex2f(center.x + arc[point].x*outerRadius, center.y + arc[point].y*outerRadius);
+            rlVertex2f(center.x + arc[point + 1].x*outerRadius, center.y + arc[point + 1].y*outerRadius);
 
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*innerRadius, center.y + cosf(DEG2RAD*angle)*innerRadius);
-            rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*innerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*innerRadius);
+            rlVertex2f(center.x + arc[point].x*innerRadius, center.y + arc[point].y*innerRadius);
+            rlVertex2f(center.x + arc[point + 1].x*innerRadius, center.y + arc[point + 1].y*innerRadius);
 
-            angle += stepLength;
+            point++;
         }
 
         if (showCapLines)
         {
             rlColor4ub(color.r, color.g, color.b, color.a);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*outerRadius, center.y + cosf(DEG2RAD*angle)*outerRadius);
-            rlVertex2f(center.x + sinf(DEG2RAD*angle)*innerRadius, center.y + cosf(DEG2RAD*angle)*innerRadius);
+            rlVertex2f(center.x + arc[point].x*outerRadius, center.y + arc[point].y*outerRadius);
+            rlVertex2f(center.x + arc[point].x*innerRadius, center.y + arc[point].y*innerRadius);
         }
     rlEnd();
 }
@@ -931,7 +1063,8 @@ void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color co
         // Draw all of the 4 corners: [1] Upper Left Corner, [3] Upper Right Corner, [5] Lower Right Corner, [7] Lower Left Corner
         for (int k = 0; k < 4; ++k) // Hope the compiler is smart enough to unroll this loop
         {
-            float angle = angles[k];
+            const Vector2 *arc = GetCircleArc(angles[k], stepLength, segments);
+            int point = 0;      // Current point on the corner arc
             const Vector2 center = centers[k];
 
             // NOTE: Every QUAD actually represents two segments
@@ -941,12 +1074,12 @@ void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color co
                 rlTexCoord2f(texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height);
                 rlVertex2f(center.x, center.y);
                 rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-                rlVertex2f(center.x + sinf(DEG2RAD*angle)*radius, center.y + cosf(DEG2RAD*angle)*radius);
+                rlVertex2f(center.x + arc[point].x*radius, center.y + arc[point].y*radius);
                 rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-                rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*radius, center.y + cosf(DEG2RAD*(angle + stepLength))*radius);
+                rlVertex2f(center.x + arc[point + 1].x*radius, center.y + arc[point + 1].y*radius);
                 rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
-                rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength*2))*radius, center.y + cosf(DEG2RAD*(angle + stepLength*2))*radius);
-                angle += (stepLength*2);
+                rlVertex2f(center.x + arc[point + 2].x*radius, center.y + arc[point + 2].y*radius);
+                point += 2;
             }
 
             // NOTE: In case number of segments is odd, we add one last piece to the cake
@@ -956,9 +1089,9 @@ void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color co
                 rlTexCoord2f(texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height);
                 rlVertex2f(center.x, center.y);
                 rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-                rlVertex2f(center.x + sinf(DEG2RAD*angle)*radius, center.y + cosf(DEG2RAD*angle)*radius);
+                rlVertex2f(center.x + arc[point].x*radius, center.y + arc[point].y*radius);
                 rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-                rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*radius, center.y + cosf(DEG2RAD*(angle + stepLength))*radius);
+                rlVertex2f(center.x + arc[point + 1].x*radius, center.y + arc[point + 1].y*radius);
                 rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
                 rlVertex2f(center.x, center.y);
             }
@@ -1029,15 +1162,16 @@ void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color co
         // Draw all of the 4 corners: [1] Upper Left Corner, [3] Upper Right Corner, [5] Lower Right Corner, [7] Lower Left Corner
         for (int k = 0; k < 4; ++k) // Hope the compiler is smart enough to unroll this loop
         {
-            float angle = angles[k];
+            const Vector2 *arc = GetCircleArc(angles[k], stepLength, segments);
+            int point = 0;      // Current point on the corner arc
             const Vector2 center = centers[k];
             for (int i = 0; i < segments; i++)
             {
                 rlColor4ub(color.r, color.g, color.b, color.a);
                 rlVertex2f(center.x, center.y);
-                rlVertex2f(center.x + sinf(DEG2RAD*angle)*radius, center.y + cosf(DEG2RAD*angle)*radius);
-                rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*radius, center.y + cosf(DEG2RAD*(angle + stepLength))*radius);
-                angle += stepLength;
+                rlVertex2f(center.x + arc[point].x*radius, center.y + arc[point].y*radius);
+                rlVertex2f(center.x + arc[point + 1].x*radius, center.y + arc[point + 1].y*radius);
+                point++;
             }
         }
 
@@ -1164,21 +1298,22 @@ void DrawRectangleRoundedLines(Rectangle rec, float roundness, int segments, flo
             // Draw all of the 4 corners first: Upper Left Corner, Upper Right Corner, Lower Right Corner, Lower Left Corner
             for (int k = 0; k < 4; ++k) // Hope the compiler is smart enough to unroll this loop
             {
-                float angle = angles[k];
+                const Vector2 *arc = GetCircleArc(angles[k], stepLength, segments);
+                int point = 0;      // Current point on the corner arc
                 const Vector2 center = centers[k];
                 for (int i = 0; i < segments; i++)
                 {
                     rlColor4ub(color.r, color.g, color.b, color.a);
                     rlTexCoord2f(texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height);
-                    rlVertex2f(center.x + sinf(DEG2RAD*angle)*innerRadius, center.y + cosf(DEG2RAD*angle)*innerRadius);
+                    rlVertex2f(center.x + arc[point].x*innerRadius, center.y + arc[point].y*innerRadius);
                     rlTexCoord2f(texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-                    rlVertex2f(center.x + sinf(DEG2RAD*angle)*outerRadius, center.y + cosf(DEG2RAD*angle)*outerRadius);
+                    rlVertex2f(center.x + arc[point].x*outerRadius, center.y + arc[point].y*outerRadius);
                     rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
-                    rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*outerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*outerRadius);
+                    rlVertex2f(center.x + arc[point + 1].x*outerRadius, center.y + arc[point + 1].y*outerRadius);
                     rlTexCoord2f((texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height);
-                    rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*innerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*innerRadius);
+                    rlVertex2f(center.x + arc[point + 1].x*innerRadius, center.y + arc[point + 1].y*innerRadius);
 
-                    angle += stepLength;
+                    point++;
                 }
             }
 
@@ -1236,22 +1371,23 @@ void DrawRectangleRoundedLines(Rectangle rec, float roundness, int segments, flo
             // Draw all of the 4 corners first: Upper Left Corner, Upper Right Corner, Lower Right Corner, Lower Left Corner
             for (int k = 0; k < 4; ++k) // Hope the compiler is smart enough to unroll this loop
             {
-                float angle = angles[k];
+                const Vector2 *arc = GetCircleArc(angles[k], stepLength, segments);
+                int point = 0;      // Current point on the corner arc
                 const Vector2 center = centers[k];
 
                 for (int i = 0; i < segments; i++)
                 {
                     rlColor4ub(color.r, color.g, color.b, color.a);
 
-                    rlVertex2f(center.x + sinf(DEG2RAD*angle)*innerRadius, center.y + cosf(DEG2RAD*angle)*innerRadius);
-                    rlVertex2f(center.x + sinf(DEG2RAD*angle)*outerRadius, center.y + cosf(DEG2RAD*angle)*outerRadius);
-                    rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*innerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*innerRadius);
+                    rlVertex2f(center.x + arc[point].x*innerRadius, center.y + arc[point].y*innerRadius);
+                    rlVertex2f(center.x + arc[point].x*outerRadius, center.y + arc[point].y*outerRadius);
+                    rlVertex2f(center.x + arc[point + 1].x*innerRadius, center.y + arc[point + 1].y*innerRadius);
 
-                    rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*innerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*innerRadius);
-                    rlVertex2f(center.x + sinf(DEG2RAD*angle)*outerRadius, center.y + cosf(DEG2RAD*angle)*outerRadius);
-                    rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*outerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*outerRadius);
+                    rlVertex2f(center.x + arc[point + 1].x*innerRadius, center.y + arc[point + 1].y*innerRadius);
+                    rlVertex2f(center.x + arc[point].x*outerRadius, center.y + arc[point].y*outerRadius);
+                    rlVertex2f(center.x + arc[point + 1].x*outerRadius, center.y + arc[point + 1].y*outerRadius);
 
-                    angle += stepLength;
+                    point++;
                 }
             }
 
@@ -1303,15 +1439,16 @@ void DrawRectangleRoundedLines(Rectangle rec, float roundness, int segments, flo
             // Draw all of the 4 corners first: Upper Left Corner, Upper Right Corner, Lower Right Corner, Lower Left Corner
             for (int k = 0; k < 4; ++k) // Hope the compiler is smart enough to unroll this loop
             {
-                float angle = angles[k];
+                const Vector2 *arc = GetCircleArc(angles[k], stepLength, segments);
+                int point = 0;      // Current point on the corner arc
                 const Vector2 center = centers[k];
 
                 for (int i = 0; i < segments; i++)
                 {
                     rlColor4ub(color.r, color.g, color.b, color.a);
-                    rlVertex2f(center.x + sinf(DEG2RAD*angle)*outerRadius, center.y + cosf(DEG2RAD*angle)*outerRadius);
-                    rlVertex2f(center.x + sinf(DEG2RAD*(angle + stepLength))*outerRadius, center.y + cosf(DEG2RAD*(angle + stepLength))*outerRadius);
-                    angle += stepLength;
+                    rlVertex2f(center.x + arc[point].x*outerRadius, center.y + arc[point].y*outerRadius);
+                    rlVertex2f(center.x + arc[point + 1].x*outerRadius, center.y + arc[point + 1].y*outerRadius);
+                    point++;
                 }
             }
 
@@ -1803,6 +1940,80 @@ Rectangle GetCollisionRec(Rectangle rec1, Rectangle rec2)
 // Module specific Functions Definition
 //----------------------------------------------------------------------------------
 
+// Get the unit circle points (sinf, cosf) of an arc, segments + 1 points starting at startAngle
+// NOTE: Arcs on a circle divided in a whole number of segments (i.e. full circles, rounded corners)
+// are read from a cached table, others are generated rotating the previous point by the step angle,
+// so there is no sinf()/cosf() call per vertex. Returned points are valid until next call
+static const Vector2 *GetCircleArc(float startAngle, float stepLength, int segments)
+{
+    // NOTE: A zero step (startAngle == endAngle) collapses the arc into its start point
+    if (stepLength == 0.0f)
+    {
+        if (arcPointsCapacity < segments + 1)
+        {
+            arcPoints = (Vector2 *)RL_REALLOC(arcPoints, (segments + 1)*sizeof(Vector2));
+            arcPointsCapacity = segments + 1;
+        }
+
+        Vector2 point = { sinf(DEG2RAD*startAngle), cosf(DEG2RAD*startAngle) };
+        for (int i = 0; i <= segments; i++) arcPoints[i] = point;
+
+        return arcPoints;
+    }
+
+    float turnSegments = 360.0f/stepLength;
+    float startSegment = startAngle/stepLength;
+    int tableSegments = (int)roundf(turnSegments);
+    int tableStart = (int)roundf(startSegment);
+
+    if ((tableSegments > 0) && (tableSegments <= MAX_CIRCLE_TABLE_SEGMENTS) && (segments <= tableSegments) &&
+        (fabsf(turnSegments - tableSegments) < 0.001f) && (fabsf(startSegment - tableStart) < 0.001f))
+    {
+        CircleTable *table = NULL;
+
+        for (int i = 0; i < MAX_CIRCLE_TABLES; i++)
+        {
+            if (circleTables[i].segments == tableSegments) { table = &circleTables[i]; break; }
+        }
+
+        if (table == NULL)
+        {
+            table = &circleTables[circleTableNext];
+            circleTableNext = (circleTableNext + 1)%MAX_CIRCLE_TABLES;
+
+            for (int i = 0; i <= 2*tableSegments; i++)
+            {
+                float angle = 2*PI*(float)i/(float)tableSegments;
+                table->points[i] = (Vector2){ sinf(angle), cosf(angle) };
+            }
+            table->segments = tableSegments;
+        }
+
+        tableStart %= tableSegments;
+        if (tableStart < 0) tableStart += tableSegments;
+
+        return table->points + tableStart;
+    }
+
+    if (arcPointsCapacity < segments + 1)
+    {
+        arcPoints = (Vector2 *)RL_REALLOC(arcPoints, (segments + 1)*sizeof(Vector2));
+        arcPointsCapacity = segments + 1;
+    }
+
+    float stepSin = sinf(DEG2RAD*stepLength);
+    float stepCos = cosf(DEG2RAD*stepLength);
+    Vector2 point = { sinf(DEG2RAD*startAngle), cosf(DEG2RAD*startAngle) };
+
+    for (int i = 0; i <= segments; i++)
+    {
+        arcPoints[i] = point;
+        point = (Vector2){ point.x*stepCos + point.y*stepSin, point.y*stepCos - point.x*stepSin };
+    }
+
+    return arcPoints;
+}
+
 // Cubic easing in-out
 // NOTE: Used by DrawLineBezier() only
 static float EaseCubicInOut(float t, float b, float c, float d)
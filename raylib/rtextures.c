@@ -38,6 +38,7 @@
 *       stb_image        - Multiple image formats loading (JPEG, PNG, BMP, TGA, PSD, GIF, PIC)
 *                          NOTE: stb_image has been slightly modified to support Android platform.
 *       stb_image_resize - Multiple image resize algorithms
+*       stb_rect_pack    - Rectangles packing algorithms, required for image atlas generation
 *
 *
 *   LICENSE: zlib/libpng
@@ -153,6 +154,10 @@
 
     #define STB_IMAGE_RESIZE_IMPLEMENTATION
     #include "external/stb_image_resize.h"  // Required for: stbir_resize_uint8() [ImageResize()]
+
+    #define STBRP_STATIC                    // Keep symbols private, rtext also implements stb_rect_pack
+    #define STB_RECT_PACK_IMPLEMENTATION
+    #include "external/stb_rect_pack.h"     // Required for: stbrp_pack_rects() [GenImageAtlas()]
 #endif
 
 //----------------------------------------------------------------------------------
@@ -162,6 +167,10 @@
     #define PIXELFORMAT_UNCOMPRESSED_R5G5B5A1_ALPHA_THRESHOLD  50    // Threshold over 255 to set alpha as 0
 #endif
 
+#ifndef MAX_IMAGE_ATLAS_SIZE
+    #define MAX_IMAGE_ATLAS_SIZE      4096      // Maximum image atlas size (width and height), supported by most GPUs
+#endif
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -198,6 +207,7 @@ static Image LoadASTC(const unsigned char *fileData, unsigned int fileSize);  //
 #endif
 
 static Vector4 *LoadImageDataNormalized(Image image);       // Load pixel data from image as Vector4 array (float normalized)
+static void ImageDrawSpan(Image *dst, int posX, int posY, int width, Color color);  // Draw horizontal span of pixels within an image
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition
@@ -1215,6 +1225,108 @@ Image ImageTextEx(Font font, const char *text, float fontSize, float spacing, Co
     return imText;
 }
 
+// Create an atlas image packing multiple images (skyline rect packing)
+// NOTE: Atlas is RGBA8 and POT, it grows until all images fit (up to MAX_IMAGE_ATLAS_SIZE),
+// rectangles (image position in atlas) memory is loaded here, free with UnloadImageAtlasRecs()
+Image GenImageAtlas(const Image *images, int imageCount, int padding, Rectangle **recs)
+{
+    Image atlas = { 0 };
+    *recs = NULL;
+
+    if ((images == NULL) || (imageCount <= 0))
+    {
+        TRACELOG(LOG_WARNING, "IMAGE: No images provided for atlas");
+        return atlas;
+    }
+
+    stbrp_rect *rects = (stbrp_rect *)RL_CALLOC(imageCount, sizeof(stbrp_rect));
+
+    // Start from the smallest POT size covering required area and largest image
+    int requiredArea = 0;
+    int requiredSize = 1;
+
+    for (int i = 0; i < imageCount; i++)
+    {
+        rects[i].id = i;
+
+        // NOTE: Compressed images can not be copied into atlas, they take no space
+        if (images[i].format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) continue;
+
+        rects[i].w = images[i].width + 2*padding;
+        rects[i].h = images[i].height + 2*padding;
+
+        requiredArea += rects[i].w*rects[i].h;
+        if (rects[i].w > requiredSize) requiredSize = rects[i].w;
+        if (rects[i].h > requiredSize) requiredSize = rects[i].h;
+    }
+
+    int atlasSize = 1;
+    while ((atlasSize < requiredSize) || ((atlasSize*atlasSize) < requiredArea)) atlasSize *= 2;
+
+    if (atlasSize > MAX_IMAGE_ATLAS_SIZE)
+    {
+        TRACELOG(LOG_WARNING, "IMAGE: Images do not fit in maximum atlas size (%ix%i)", MAX_IMAGE_ATLAS_SIZE, MAX_IMAGE_ATLAS_SIZE);
+        RL_FREE(rects);
+        return atlas;
+    }
+
+    stbrp_context *context = (stbrp_context *)RL_MALLOC(sizeof(*context));
+    stbrp_node *nodes = NULL;
+    bool packed = false;
+
+    while (!packed && (atlasSize <= MAX_IMAGE_ATLAS_SIZE))
+    {
+        // NOTE: Skyline packing requires one node per atlas column for best results
+        nodes = (stbrp_node *)RL_REALLOC(nodes, atlasSize*sizeof(stbrp_node));
+        stbrp_init_target(context, atlasSize, atlasSize, nodes, atlasSize);
+        stbrp_setup_heuristic(context, STBRP_HEURISTIC_Skyline_BL_sortHeight);
+
+        packed = (stbrp_pack_rects(context, rects, imageCount) == 1);
+        if (!packed) atlasSize *= 2;
+    }
+
+    if (atlasSize > MAX_IMAGE_ATLAS_SIZE) atlasSize = MAX_IMAGE_ATLAS_SIZE;
+
+    atlas = GenImageColor(atlasSize, atlasSize, BLANK);
+    *recs = (Rectangle *)RL_CALLOC(imageCount, sizeof(Rectangle));
+
+    for (int i = 0; i < imageCount; i++)
+    {
+        if (images[i].format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) TRACELOG(LOG_WARNING, "IMAGE: Atlas packing not supported for compressed formats (%i)", i);
+        else if (rects[i].was_packed)
+        {
+            (*recs)[i] = (Rectangle){ (float)(rects[i].x + padding), (float)(rects[i].y + padding), (float)images[i].width, (float)images[i].height };
+
+            // Copy image rows into atlas, no blending required
+            Image image = ImageCopy(images[i]);
+            ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+            for (int y = 0; y < image.height; y++)
+            {
+                memcpy((Color *)atlas.data + (rects[i].y + padding + y)*atlas.width + rects[i].x + padding,
+                       (Color *)image.data + y*image.width, image.width*sizeof(Color));
+            }
+
+            UnloadImage(image);
+        }
+        else TRACELOG(LOG_WARNING, "IMAGE: Failed to pack image (%i) into atlas", i);
+    }
+
+    RL_FREE(nodes);
+    RL_FREE(context);
+    RL_FREE(rects);
+
+    if (packed) TRACELOG(LOG_INFO, "IMAGE: Atlas created successfully (%ix%i, %i images)", atlasSize, atlasSize, imageCount);
+
+    return atlas;
+}
+
+// Unload image atlas rectangles loaded with GenImageAtlas()
+void UnloadImageAtlasRecs(Rectangle *recs)
+{
+    RL_FREE(recs);
+}
+
 // Crop image depending on alpha value
 // NOTE: Threshold is defined as a percentatge: 0.0f -> 1.0f
 void ImageAlphaCrop(Image *image, float threshold)
@@ -2416,17 +2528,7 @@ void ImageClearBackground(Image *dst, Color color)
     // Security check to avoid program crash
     if ((dst->data == NULL) || (dst->width == 0) || (dst->height == 0)) return;
 
-    // Fill in first pixel based on image format
-    ImageDrawPixel(dst, 0, 0, color);
-
-    unsigned char *pSrcPixel = (unsigned char *)dst->data;
-    int bytesPerPixel = GetPixelDataSize(1, 1, dst->format);
-
-    // Repeat the first pixel data throughout the image
-    for (int i = 1; i < dst->width * dst->height; i++)
-    {
-        memcpy(pSrcPixel + i * bytesPerPixel, pSrcPixel, bytesPerPixel);
-    }
+    for (int y = 0; y < dst->height; y++) ImageDrawSpan(dst, 0, y, dst->width, color);
 }
 
 // Draw pixel within an image
@@ -2555,6 +2657,14 @@ void ImageDrawLine(Image *dst, int startPosX, int startPosY, int endPosX, int en
     // Drawing Lines with Pixels - Joshua Scott - March 2012
     // https://classic.csunplugged.org/wp-content/uploads/2014/12/Lines.pdf
 
+    // Fast path: horizontal lines are drawn as a single span
+    if (startPosY == endPosY)
+    {
+        if (startPosX <= endPosX) ImageDrawSpan(dst, startPosX, startPosY, endPosX - startPosX + 1, color);
+        else ImageDrawSpan(dst, endPosX, startPosY, startPosX - endPosX + 1, color);
+        return;
+    }
+
     int changeInX = (endPosX - startPosX);
     int absChangeInX = (changeInX < 0)? -changeInX : changeInX;
     int changeInY = (endPosY - startPosY);
@@ -2678,6 +2788,36 @@ void ImageDrawCircleV(Image *dst, Vector2 center, int radius, Color color)
     ImageDrawCircle(dst, (int)center.x, (int)center.y, radius, color);
 }
 
+// Draw filled circle within an image
+// NOTE: Circle is filled with horizontal spans, one per midpoint algorithm step and octant pair
+void ImageDrawCircleFilled(Image *dst, int centerX, int centerY, int radius, Color color)
+{
+    int x = 0, y = radius;
+    int decesionParameter = 3 - 2*radius;
+
+    while (y >= x)
+    {
+        ImageDrawSpan(dst, centerX - x, centerY + y, x*2 + 1, color);
+        ImageDrawSpan(dst, centerX - x, centerY - y, x*2 + 1, color);
+        ImageDrawSpan(dst, centerX - y, centerY + x, y*2 + 1, color);
+        ImageDrawSpan(dst, centerX - y, centerY - x, y*2 + 1, color);
+        x++;
+
+        if (decesionParameter > 0)
+        {
+            y--;
+            decesionParameter = decesionParameter + 4*(x - y) + 10;
+        }
+        else decesionParameter = decesionParameter + 4*x + 6;
+    }
+}
+
+// Draw filled circle within an image (Vector version)
+void ImageDrawCircleFilledV(Image *dst, Vector2 center, int radius, Color color)
+{
+    ImageDrawCircleFilled(dst, (int)center.x, (int)center.y, radius, color);
+}
+
 // Draw rectangle within an image
 void ImageDrawRectangle(Image *dst, int posX, int posY, int width, int height, Color color)
 {
@@ -2699,24 +2839,11 @@ void ImageDrawRectangleRec(Image *dst, Rectangle rec, Color color)
     int sy = (int)rec.y;
     int ey = sy + (int)rec.height;
 
-    int sx = (int)rec.x;
-
-    int bytesPerPixel = GetPixelDataSize(1, 1, dst->format);
+    // Clip rows to image, spans clip columns
+    if (sy < 0) sy = 0;
+    if (ey > dst->height) ey = dst->height;
 
-    for (int y = sy; y < ey; y++)
-    {
-        // Fill in the first pixel of the row based on image format
-        ImageDrawPixel(dst, sx, y, color);
-
-        int bytesOffset = ((y * dst->width) + sx) * bytesPerPixel;
-        unsigned char *pSrcPixel = (unsigned char *)dst->data + bytesOffset;
-
-        // Repeat the first pixel data throughout the row
-        for (int x = 1; x < (int)rec.width; x++)
-        {
-            memcpy(pSrcPixel + x * bytesPerPixel, pSrcPixel, bytesPerPixel);
-        }
-    }
+    for (int y = sy; y < ey; y++) ImageDrawSpan(dst, (int)rec.x, y, (int)rec.width, color);
 }
 
 // Draw rectangle lines within an image
@@ -2792,6 +2919,7 @@ void ImageDraw(Image *dst, Image src, Rectangle srcRec, Rectangle dstRec, Color
         //    [x] Consider fast path: no alpha blending required cases (src has no alpha)
         //    [x] Consider fast path: same src/dst format with no alpha -> direct line copy
         //    [-] GetPixelColor(): Get Vector4 instead of Color, easier for ColorAlphaBlend()
+        //    [x] Consider fast path: RGBA8 src/dst blending without format conversion
         //    [ ] Support f32bit channels drawing
 
         // TODO: Support PIXELFORMAT_UNCOMPRESSED_R32, PIXELFORMAT_UNCOMPRESSED_R32G32B32, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32
@@ -2818,6 +2946,14 @@ void ImageDraw(Image *dst, Image src, Rectangle srcRec, Rectangle dstRec, Color
 
             // Fast path: Avoid moving pixel by pixel if no blend required and same format
             if (!blendRequired && (srcPtr->format == dst->format)) memcpy(pDst, pSrc, (int)(srcRec.width)*bytesPerPixelSrc);
+            else if ((srcPtr->format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) && (dst->format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8))
+            {
+                // Fast path: RGBA8 pixels are Color data, blend them in place without format conversion
+                Color *pSrcColor = (Color *)pSrc;
+                Color *pDstColor = (Color *)pDst;
+
+                for (int x = 0; x < (int)srcRec.width; x++) pDstColor[x] = ColorAlphaBlend(pDstColor[x], pSrcColor[x], tint);
+            }
             else
             {
                 for (int x = 0; x < (int)srcRec.width; x++)
@@ -4854,4 +4990,40 @@ static Vector4 *LoadImageDataNormalized(Image image)
     return pixels;
 }
 
+// Draw horizontal span of pixels within an image, clipped to image bounds
+// NOTE: Pixels are written with no blending, same as ImageDrawPixel()
+static void ImageDrawSpan(Image *dst, int posX, int posY, int width, Color color)
+{
+    // Security check to avoid program crash
+    if ((dst->data == NULL) || (posY < 0) || (posY >= dst->height)) return;
+
+    if (posX < 0) { width += posX; posX = 0; }
+    if ((posX + width) > dst->width) width = dst->width - posX;
+    if (width <= 0) return;
+
+    if (dst->format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+    {
+        // Fast path: RGBA8 pixels are Color data, a plain loop the compiler can vectorize
+        Color *pixels = (Color *)dst->data + posY*dst->width + posX;
+
+        for (int x = 0; x < width; x++) pixels[x] = color;
+    }
+    else
+    {
+        // Fill in the first pixel based on image format
+        ImageDrawPixel(dst, posX, posY, color);
+
+        int bytesPerPixel = GetPixelDataSize(1, 1, dst->format);
+        unsigned char *pSrcPixel = (unsigned char *)dst->data + (posY*dst->width + posX)*bytesPerPixel;
+
+        // Repeat already filled pixels throughout the span, doubling the copy size every step
+        for (int filled = 1; filled < width; )
+        {
+            int count = ((width - filled) < filled)? (width - filled) : filled;
+            memcpy(pSrcPixel + filled*bytesPerPixel, pSrcPixel, count*bytesPerPixel);
+            filled += count;
+        }
+    }
+}
+
 #endif      // SUPPORT_MODULE_RTEXTURES